@@ -0,0 +1,62 @@
+# Compiles a generated translation unit for each of the PLACEHOLDER_COUNTS, and prints the compilation time, and the
+# peak memory usage of the compiler when GNU time is available.
+
+string(REPLACE "," ";" PLACEHOLDER_COUNTS "${PLACEHOLDER_COUNTS}")
+
+find_program(TIME_PROGRAM time)
+
+message("Placeholders\tTime (s)\tMemory (kB)")
+
+foreach(count IN LISTS PLACEHOLDER_COUNTS)
+    set(format_str "")
+    set(args "")
+    foreach(i RANGE 1 ${count})
+        string(APPEND format_str " v${i}=%d")
+        if(i EQUAL 1)
+            string(APPEND args "argc")
+        else()
+            string(APPEND args ", argc + ${i}")
+        endif()
+    endforeach()
+
+    set(source "${WORK_DIR}/placeholders_${count}.cpp")
+    file(WRITE ${source} "\
+#include \"const_format.h\"
+
+using namespace std::literals::string_view_literals;
+
+static constexpr auto format_str = \"${format_str}\"sv;
+
+int main(int argc, char**)
+{
+    const auto str = cst_fmt::format<format_str>(${args});
+    return str[str.effective_size() - 1];
+}
+")
+
+    set(command ${CXX_COMPILER} ${CXX_STANDARD_FLAG} -O2 -I${INCLUDE_DIR} -c ${source} -o ${source}.o)
+    if(TIME_PROGRAM)
+        set(command ${TIME_PROGRAM} -f "%M" ${command})
+    endif()
+
+    string(TIMESTAMP start "%s%f")
+    execute_process(COMMAND ${command} RESULT_VARIABLE result ERROR_VARIABLE output)
+    string(TIMESTAMP end "%s%f")
+
+    math(EXPR elapsed_ms "(${end} - ${start}) / 1000")
+    math(EXPR seconds "${elapsed_ms} / 1000")
+    math(EXPR milliseconds "${elapsed_ms} % 1000 + 1000")
+    string(SUBSTRING ${milliseconds} 1 3 milliseconds)
+
+    set(memory "-")
+    if(TIME_PROGRAM)
+        string(REGEX MATCH "[0-9]+[\r\n]*$" memory "${output}")
+        string(STRIP "${memory}" memory)
+    endif()
+
+    if(NOT result EQUAL 0)
+        message("${count}\t\tfailed to compile")
+    else()
+        message("${count}\t\t${seconds}.${milliseconds}\t\t${memory}")
+    endif()
+endforeach()
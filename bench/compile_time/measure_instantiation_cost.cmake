@@ -0,0 +1,154 @@
+# Compiles a generated translation unit for each pair of FORMAT_COUNTS and PLACEHOLDER_COUNTS, with the time report of
+# the compiler, and tabulates the front-end time spent formatting.
+#
+# GCC (-ftime-report) only reports totals by category: the template instantiation and constant evaluation times, with
+# the memory allocated by the front-end.
+# Clang (-ftime-trace) reports each instantiation: the time spent in each of the TRACKED_FUNCTIONS is summed, nested
+# instantiations included.
+
+string(REPLACE "," ";" FORMAT_COUNTS "${FORMAT_COUNTS}")
+string(REPLACE "," ";" PLACEHOLDER_COUNTS "${PLACEHOLDER_COUNTS}")
+
+set(TRACKED_FUNCTIONS parse_format format_holes get_formatted_str_length_start format_internal
+                      formatted_str_length format_to_str)
+
+# Types of the placeholders, used in turn
+set(PLACEHOLDER_SPECS "%d" "%x" "%.3f" "%s")
+set(PLACEHOLDER_ARGS "i" "unsigned(i)" "double(i)" "cst_fmt::cstr<16>{s}")
+
+
+# Writes a translation unit with 'formats' different formats of 'placeholders' arguments each.
+function(generate_source path formats placeholders)
+    set(content "#include \"const_format.h\"\n\nusing namespace std::literals::string_view_literals;\n\n")
+    set(calls "")
+    if(formats GREATER 0)
+        math(EXPR last_format "${formats} - 1")
+        foreach(f RANGE ${last_format})
+            set(format_str "f${f}")
+            set(args "")
+            foreach(p RANGE 1 ${placeholders})
+                math(EXPR type "${p} % 4")
+                list(GET PLACEHOLDER_SPECS ${type} spec)
+                list(GET PLACEHOLDER_ARGS ${type} arg)
+                string(APPEND format_str " v${p}=${spec}")
+                if(p GREATER 1)
+                    string(APPEND args ", ")
+                endif()
+                string(APPEND args "${arg}")
+            endforeach()
+            string(APPEND content "\
+static constexpr auto format_${f} = \"${format_str}\"sv;
+
+int use_format_${f}(int i, const char* s)
+{
+    const auto str = cst_fmt::format<format_${f}>(${args});
+    return str[str.effective_size() - 1];
+}
+
+")
+            string(APPEND calls "    result += use_format_${f}(argc, argv[0]);\n")
+        endforeach()
+    endif()
+    string(APPEND content "int main(int argc, char** argv)\n{\n    int result = 0;\n${calls}    return result;\n}\n")
+    file(WRITE ${path} "${content}")
+endfunction()
+
+
+# Returns the wall time and the memory of a line of the GCC time report.
+function(gcc_report_entry report name out_time out_memory)
+    string(REGEX MATCH " ${name} *:([^\n]*)" _ "${report}")
+    # usr, sys and wall times, each followed by their percentage, then the memory
+    string(REGEX MATCHALL "[0-9.]+[kMG]?" numbers "${CMAKE_MATCH_1}")
+    set(time "-")
+    set(memory "-")
+    if(name STREQUAL "TOTAL")
+        list(LENGTH numbers length)
+        if(length GREATER_EQUAL 4)
+            list(GET numbers 2 time)
+            list(GET numbers 3 memory)
+        endif()
+    else()
+        list(LENGTH numbers length)
+        if(length GREATER_EQUAL 7)
+            list(GET numbers 4 time)
+            list(GET numbers 6 memory)
+        endif()
+    endif()
+    set(${out_time} ${time} PARENT_SCOPE)
+    set(${out_memory} ${memory} PARENT_SCOPE)
+endfunction()
+
+
+# Returns the sum of the durations of the events of the Clang time trace matching 'pattern', in milliseconds.
+function(clang_trace_duration trace pattern out_ms)
+    string(REGEX MATCHALL "\"dur\":[0-9]+,\"name\":\"${pattern}" events "${trace}")
+    set(total 0)
+    foreach(event IN LISTS events)
+        string(REGEX MATCH "\"dur\":([0-9]+)" _ "${event}")
+        math(EXPR total "${total} + ${CMAKE_MATCH_1}")
+    endforeach()
+    # Durations are in microseconds
+    math(EXPR total_ms "${total} / 1000")
+    set(${out_ms} ${total_ms} PARENT_SCOPE)
+endfunction()
+
+
+if(COMPILER_ID STREQUAL "GNU")
+    message("Formats\tPlaceholders\tTotal (s)\tParsing (s)\tDeferred (s)\tInstantiation (s)\tConstexpr (s)\tFront-end memory")
+elseif(COMPILER_ID MATCHES "Clang")
+    string(REPLACE ";" " (ms)\t" tracked_header "${TRACKED_FUNCTIONS}")
+    message("Formats\tPlaceholders\tFront-end (ms)\t${tracked_header} (ms)")
+else()
+    message(FATAL_ERROR "Only GCC and Clang have a detailed time report")
+endif()
+
+# The cost of the header alone, then of each pair
+set(cases "0:0")
+foreach(formats IN LISTS FORMAT_COUNTS)
+    foreach(placeholders IN LISTS PLACEHOLDER_COUNTS)
+        list(APPEND cases "${formats}:${placeholders}")
+    endforeach()
+endforeach()
+
+foreach(case IN LISTS cases)
+    string(REPLACE ":" ";" case "${case}")
+    list(GET case 0 formats)
+    list(GET case 1 placeholders)
+
+    set(name "formats_${formats}_placeholders_${placeholders}")
+    set(source "${WORK_DIR}/${name}.cpp")
+    set(object "${WORK_DIR}/${name}.o")
+    generate_source(${source} ${formats} ${placeholders})
+
+    set(command ${CXX_COMPILER} ${CXX_STANDARD_FLAG} -O0 -I${INCLUDE_DIR} -c ${source} -o ${object})
+    if(COMPILER_ID STREQUAL "GNU")
+        list(APPEND command -ftime-report)
+    else()
+        list(APPEND command -ftime-trace -ftime-trace-granularity=0)
+    endif()
+
+    execute_process(COMMAND ${command} RESULT_VARIABLE result ERROR_VARIABLE report)
+    if(NOT result EQUAL 0)
+        message("${formats}\t${placeholders}\t\tfailed to compile")
+        continue()
+    endif()
+
+    if(COMPILER_ID STREQUAL "GNU")
+        gcc_report_entry("${report}" "TOTAL" total total_memory)
+        gcc_report_entry("${report}" "phase parsing" parsing parsing_memory)
+        gcc_report_entry("${report}" "phase lang. deferred" deferred deferred_memory)
+        gcc_report_entry("${report}" "template instantiation" instantiation instantiation_memory)
+        gcc_report_entry("${report}" "constant expression evaluation" constexpr constexpr_memory)
+        message("${formats}\t${placeholders}\t\t${total}\t\t${parsing}\t\t${deferred}\t\t${instantiation}\t\t\t${constexpr}\t\t${parsing_memory} + ${deferred_memory}")
+    else()
+        # The trace is written next to the object file
+        file(READ "${WORK_DIR}/${name}.json" trace)
+        clang_trace_duration("${trace}" "Total Frontend\"" frontend)
+        set(line "${formats}\t${placeholders}\t\t${frontend}")
+        foreach(function IN LISTS TRACKED_FUNCTIONS)
+            clang_trace_duration("${trace}" "Instantiate[A-Za-z]+\",\"args\":{\"detail\":\"[^\"]*::${function}<" time)
+            string(APPEND line "\t\t${time}")
+        endforeach()
+        message("${line}")
+    endif()
+endforeach()
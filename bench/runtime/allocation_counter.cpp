@@ -0,0 +1,21 @@
+#include <cstdint>
+#include <cstdlib>
+#include <new>
+
+
+// Read by the benchmarks: the number of bytes allocated since the start of the program
+uint64_t allocated_bytes = 0;
+
+
+void* operator new(size_t size)
+{
+    allocated_bytes += size;
+    if (void* ptr = std::malloc(size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+
+void operator delete(void* ptr) noexcept { std::free(ptr); }
+void operator delete(void* ptr, size_t) noexcept { std::free(ptr); }
@@ -0,0 +1,551 @@
+
+#include "../../const_format.h"
+
+#include <charconv>
+#include <cmath>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#if __has_include(<format>)
+#include <format>
+#endif
+
+#if defined(__linux__) && __has_include(<linux/perf_event.h>)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define HAS_PERF_EVENT 1
+#endif
+
+
+using namespace std::literals::string_view_literals;
+
+
+// Number of formatted values for each measure
+constexpr size_t OPS_COUNT = 1 << 20;
+// Number of different values, cycled through until 'OPS_COUNT' is reached
+constexpr size_t INPUTS_COUNT = 4096;
+
+
+// All heap allocations are counted, to report the bytes allocated by each formatting call.
+// The replacement operators are in their own translation unit, so that they are never inlined here.
+extern uint64_t allocated_bytes;
+
+
+/**
+ * Makes the compiler assume that the memory pointed to is read, so that writing to it cannot be optimized away.
+ */
+inline void do_not_optimize(const char* ptr)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r"(ptr) : "memory");
+#else
+    static const char* volatile escaped;
+    escaped = ptr;
+#endif
+}
+
+
+/**
+ * Counts the instructions executed in user space by this thread, if the kernel allows it.
+ */
+class InstructionCounter
+{
+    int m_fd = -1;
+
+public:
+    InstructionCounter()
+    {
+#ifdef HAS_PERF_EVENT
+        perf_event_attr attr{};
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        m_fd = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~InstructionCounter()
+    {
+#ifdef HAS_PERF_EVENT
+        if (m_fd >= 0) {
+            close(m_fd);
+        }
+#endif
+    }
+
+    [[nodiscard]]
+    bool available() const { return m_fd >= 0; }
+
+    void start()
+    {
+#ifdef HAS_PERF_EVENT
+        if (available()) {
+            ioctl(m_fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(m_fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    uint64_t stop()
+    {
+        uint64_t count = 0;
+#ifdef HAS_PERF_EVENT
+        if (available()) {
+            ioctl(m_fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(m_fd, &count, sizeof(count)) != sizeof(count)) {
+                count = 0;
+            }
+        }
+#endif
+        return count;
+    }
+};
+
+
+struct Result
+{
+    std::string benchmark;
+    std::string implementation;
+    double ns_per_op;
+    double heap_bytes_per_op;
+    double output_bytes_per_op;
+    std::optional<double> instructions_per_op;
+};
+
+
+std::vector<Result> results;
+InstructionCounter instruction_counter;
+
+
+/**
+ * Formats all inputs in a loop with 'func', which writes to the buffer and returns the length of the result.
+ */
+template<typename T, typename Func>
+void measure(const char* benchmark, const char* implementation, const std::vector<T>& inputs, Func&& func)
+{
+    char buffer[512];
+
+    // Warm up the caches and the branch predictors
+    for (const T& input : inputs) {
+        func(buffer, input);
+        do_not_optimize(buffer);
+    }
+
+    const size_t repetitions = OPS_COUNT / inputs.size();
+    const double ops = double(repetitions * inputs.size());
+    uint64_t output_bytes = 0;
+
+    const uint64_t allocated_start = allocated_bytes;
+    instruction_counter.start();
+    const auto start = std::chrono::steady_clock::now();
+
+    for (size_t i = 0; i < repetitions; i++) {
+        for (const T& input : inputs) {
+            output_bytes += func(buffer, input);
+            do_not_optimize(buffer);
+        }
+    }
+
+    const auto end = std::chrono::steady_clock::now();
+    const uint64_t instructions = instruction_counter.stop();
+    const uint64_t allocated = allocated_bytes - allocated_start;
+
+    const std::chrono::duration<double, std::nano> time = end - start;
+
+    Result& result = results.emplace_back();
+    result.benchmark = benchmark;
+    result.implementation = implementation;
+    result.ns_per_op = time.count() / ops;
+    result.heap_bytes_per_op = double(allocated) / ops;
+    result.output_bytes_per_op = double(output_bytes) / ops;
+    if (instruction_counter.available()) {
+        result.instructions_per_op = double(instructions) / ops;
+    }
+}
+
+
+size_t copy_string(char* out, const std::string& str)
+{
+    std::memcpy(out, str.data(), str.size());
+    return str.size();
+}
+
+
+//
+// Inputs
+//
+
+
+/**
+ * Random integers with a random number of significant bits, to cover all lengths evenly.
+ */
+template<typename T>
+std::vector<T> random_integers(std::mt19937_64& rng)
+{
+    std::vector<T> values(INPUTS_COUNT);
+    for (T& val : values) {
+        val = T(rng() >> (rng() % 64));
+    }
+    return values;
+}
+
+
+std::vector<double> random_doubles(std::mt19937_64& rng)
+{
+    std::uniform_real_distribution<double> mantissa(1, 10);
+    std::uniform_int_distribution<int> exponent(-10, 10);
+    std::vector<double> values(INPUTS_COUNT);
+    for (double& val : values) {
+        val = mantissa(rng) * std::pow(10.0, exponent(rng));
+    }
+    return values;
+}
+
+
+std::vector<std::string> random_strings(std::mt19937_64& rng, size_t length)
+{
+    std::uniform_int_distribution<int> chars('a', 'z');
+    std::vector<std::string> values(INPUTS_COUNT);
+    for (std::string& str : values) {
+        str.resize(length);
+        for (char& c : str) {
+            c = char(chars(rng));
+        }
+    }
+    return values;
+}
+
+
+//
+// Benchmarks
+//
+
+
+static constexpr auto decimal_fmt = "%d"sv;
+static constexpr auto hexadecimal_fmt = "%x"sv;
+static constexpr auto float_fmt = "%f"sv;
+static constexpr auto float_precision_fmt = "%.3f"sv;
+static constexpr auto string_fmt = "%s"sv;
+static constexpr auto char_fmt = "%c"sv;
+static constexpr auto mixed_fmt = "GET %s HTTP/1.1 status=%d time=%.3f id=%x"sv;
+
+
+template<typename T>
+void bench_decimal(const char* name, std::mt19937_64& rng)
+{
+    const auto inputs = random_integers<T>(rng);
+    using Wide = std::conditional_t<std::is_signed_v<T>, long long, unsigned long long>;
+    constexpr const char* printf_fmt = std::is_signed_v<T> ? "%lld" : "%llu";
+
+    constexpr auto fmt = cst_fmt::compile_format<decimal_fmt, T>();
+    measure(name, "cst_fmt", inputs, [&](char* out, T val) {
+        return size_t(cst_fmt::format_to(fmt, out, val) - out);
+    });
+    measure(name, "snprintf", inputs, [&](char* out, T val) {
+        return size_t(std::snprintf(out, 64, printf_fmt, Wide(val)));
+    });
+    measure(name, "to_chars", inputs, [&](char* out, T val) {
+        return size_t(std::to_chars(out, out + 64, val).ptr - out);
+    });
+#ifdef __cpp_lib_format
+    measure(name, "std::format", inputs, [&](char* out, T val) {
+        return size_t(std::format_to(out, "{}", val) - out);
+    });
+#endif
+    measure(name, "ostringstream", inputs, [&](char* out, T val) {
+        std::ostringstream stream;
+        stream << Wide(val);
+        return copy_string(out, stream.str());
+    });
+}
+
+
+template<typename T>
+void bench_hexadecimal(const char* name, std::mt19937_64& rng)
+{
+    const auto inputs = random_integers<T>(rng);
+
+    constexpr auto fmt = cst_fmt::compile_format<hexadecimal_fmt, T>();
+    measure(name, "cst_fmt", inputs, [&](char* out, T val) {
+        return size_t(cst_fmt::format_to(fmt, out, val) - out);
+    });
+    measure(name, "snprintf", inputs, [&](char* out, T val) {
+        return size_t(std::snprintf(out, 64, "%llX", static_cast<unsigned long long>(val)));
+    });
+    measure(name, "to_chars", inputs, [&](char* out, T val) {
+        return size_t(std::to_chars(out, out + 64, val, 16).ptr - out);
+    });
+#ifdef __cpp_lib_format
+    measure(name, "std::format", inputs, [&](char* out, T val) {
+        return size_t(std::format_to(out, "{:X}", val) - out);
+    });
+#endif
+    measure(name, "ostringstream", inputs, [&](char* out, T val) {
+        std::ostringstream stream;
+        stream << std::hex << std::uppercase << static_cast<unsigned long long>(val);
+        return copy_string(out, stream.str());
+    });
+}
+
+
+void bench_float(std::mt19937_64& rng)
+{
+    const auto inputs = random_doubles(rng);
+
+    // Shortest representation, which parses back to the same value
+    constexpr auto shortest = cst_fmt::compile_format<float_fmt, double>();
+    measure("%f double", "cst_fmt", inputs, [&](char* out, double val) {
+        return size_t(cst_fmt::format_to(shortest, out, val) - out);
+    });
+    measure("%f double", "snprintf", inputs, [&](char* out, double val) {
+        return size_t(std::snprintf(out, 64, "%.17g", val));
+    });
+    measure("%f double", "to_chars", inputs, [&](char* out, double val) {
+        return size_t(std::to_chars(out, out + 64, val).ptr - out);
+    });
+#ifdef __cpp_lib_format
+    measure("%f double", "std::format", inputs, [&](char* out, double val) {
+        return size_t(std::format_to(out, "{}", val) - out);
+    });
+#endif
+    measure("%f double", "ostringstream", inputs, [&](char* out, double val) {
+        std::ostringstream stream;
+        stream << std::setprecision(17) << val;
+        return copy_string(out, stream.str());
+    });
+
+    constexpr auto fixed = cst_fmt::compile_format<float_precision_fmt, double>();
+    measure("%.3f double", "cst_fmt", inputs, [&](char* out, double val) {
+        return size_t(cst_fmt::format_to(fixed, out, val) - out);
+    });
+    measure("%.3f double", "snprintf", inputs, [&](char* out, double val) {
+        return size_t(std::snprintf(out, 64, "%.3f", val));
+    });
+    measure("%.3f double", "to_chars", inputs, [&](char* out, double val) {
+        return size_t(std::to_chars(out, out + 64, val, std::chars_format::fixed, 3).ptr - out);
+    });
+#ifdef __cpp_lib_format
+    measure("%.3f double", "std::format", inputs, [&](char* out, double val) {
+        return size_t(std::format_to(out, "{:.3f}", val) - out);
+    });
+#endif
+    measure("%.3f double", "ostringstream", inputs, [&](char* out, double val) {
+        std::ostringstream stream;
+        stream << std::fixed << std::setprecision(3) << val;
+        return copy_string(out, stream.str());
+    });
+}
+
+
+template<size_t N>
+void bench_string(const char* name, std::mt19937_64& rng, size_t length)
+{
+    const auto strings = random_strings(rng, length);
+    std::vector<const char*> inputs;
+    for (const std::string& str : strings) {
+        inputs.push_back(str.c_str());
+    }
+
+    constexpr auto fmt = cst_fmt::compile_format<string_fmt, cst_fmt::cstr<N>>();
+    measure(name, "cst_fmt", inputs, [&](char* out, const char* str) {
+        return size_t(cst_fmt::format_to(fmt, out, cst_fmt::cstr<N>{str}) - out);
+    });
+    measure(name, "snprintf", inputs, [&](char* out, const char* str) {
+        return size_t(std::snprintf(out, N + 1, "%s", str));
+    });
+#ifdef __cpp_lib_format
+    measure(name, "std::format", inputs, [&](char* out, const char* str) {
+        return size_t(std::format_to(out, "{}", str) - out);
+    });
+#endif
+    measure(name, "ostringstream", inputs, [&](char* out, const char* str) {
+        std::ostringstream stream;
+        stream << str;
+        return copy_string(out, stream.str());
+    });
+
+    // The size is known: no '\0' to look for
+    std::vector<std::string_view> views(strings.begin(), strings.end());
+    constexpr auto view_fmt = cst_fmt::compile_format<string_fmt, cst_fmt::sv<N>>();
+    measure(name, "cst_fmt (sv)", views, [&](char* out, std::string_view str) {
+        return size_t(cst_fmt::format_to(view_fmt, out, cst_fmt::sv<N>{str}) - out);
+    });
+}
+
+
+void bench_char(std::mt19937_64& rng)
+{
+    std::vector<char> inputs(INPUTS_COUNT);
+    for (char& c : inputs) {
+        c = char('a' + rng() % 26);
+    }
+
+    constexpr auto fmt = cst_fmt::compile_format<char_fmt, char>();
+    measure("%c", "cst_fmt", inputs, [&](char* out, char c) {
+        return size_t(cst_fmt::format_to(fmt, out, c) - out);
+    });
+    measure("%c", "snprintf", inputs, [&](char* out, char c) {
+        return size_t(std::snprintf(out, 64, "%c", c));
+    });
+#ifdef __cpp_lib_format
+    measure("%c", "std::format", inputs, [&](char* out, char c) {
+        return size_t(std::format_to(out, "{}", c) - out);
+    });
+#endif
+    measure("%c", "ostringstream", inputs, [&](char* out, char c) {
+        std::ostringstream stream;
+        stream << c;
+        return copy_string(out, stream.str());
+    });
+}
+
+
+void bench_mixed(std::mt19937_64& rng)
+{
+    const auto paths = random_strings(rng, 24);
+    const auto statuses = random_integers<int>(rng);
+    const auto times = random_doubles(rng);
+    const auto ids = random_integers<uint32_t>(rng);
+
+    using Input = std::tuple<const char*, int, double, uint32_t>;
+    std::vector<Input> inputs;
+    for (size_t i = 0; i < INPUTS_COUNT; i++) {
+        inputs.emplace_back(paths[i].c_str(), statuses[i], times[i], ids[i]);
+    }
+
+    const char* name = "mixed";
+    constexpr auto fmt = cst_fmt::compile_format<mixed_fmt, cst_fmt::cstr<64>, int, double, uint32_t>();
+    measure(name, "cst_fmt", inputs, [&](char* out, const Input& input) {
+        const auto& [path, status, time, id] = input;
+        return size_t(cst_fmt::format_to(fmt, out, cst_fmt::cstr<64>{path}, status, time, id) - out);
+    });
+    measure(name, "snprintf", inputs, [&](char* out, const Input& input) {
+        const auto& [path, status, time, id] = input;
+        return size_t(std::snprintf(out, 512, "GET %s HTTP/1.1 status=%d time=%.3f id=%X", path, status, time, id));
+    });
+#ifdef __cpp_lib_format
+    measure(name, "std::format", inputs, [&](char* out, const Input& input) {
+        const auto& [path, status, time, id] = input;
+        return size_t(std::format_to(out, "GET {} HTTP/1.1 status={} time={:.3f} id={:X}", path, status, time, id) - out);
+    });
+#endif
+    measure(name, "ostringstream", inputs, [&](char* out, const Input& input) {
+        const auto& [path, status, time, id] = input;
+        std::ostringstream stream;
+        stream << "GET " << path << " HTTP/1.1 status=" << status
+               << " time=" << std::fixed << std::setprecision(3) << time
+               << " id=" << std::hex << std::uppercase << id;
+        return copy_string(out, stream.str());
+    });
+}
+
+
+//
+// Output
+//
+
+
+void print_table(std::ostream& os)
+{
+    os << std::left << std::setw(20) << "Benchmark" << std::setw(16) << "Implementation"
+       << std::right << std::setw(12) << "ns/op" << std::setw(12) << "bytes/op" << std::setw(12) << "instr/op" << "\n";
+    os << std::fixed << std::setprecision(2);
+    for (const Result& result : results) {
+        os << std::left << std::setw(20) << result.benchmark << std::setw(16) << result.implementation
+           << std::right << std::setw(12) << result.ns_per_op << std::setw(12) << result.heap_bytes_per_op;
+        if (result.instructions_per_op) {
+            os << std::setw(12) << *result.instructions_per_op;
+        }
+        else {
+            os << std::setw(12) << "-";
+        }
+        os << "\n";
+    }
+    os << std::defaultfloat;
+}
+
+
+void write_json(std::ostream& os)
+{
+    os << "{\n";
+    os << "  \"compiler\": \"" << __VERSION__ << "\",\n";
+    os << "  \"ops_per_measure\": " << OPS_COUNT << ",\n";
+    os << "  \"instructions_available\": " << (instruction_counter.available() ? "true" : "false") << ",\n";
+    os << "  \"results\": [\n";
+    os << std::setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        const Result& result = results[i];
+        os << "    {";
+        os << "\"benchmark\": \"" << result.benchmark << "\", ";
+        os << "\"implementation\": \"" << result.implementation << "\", ";
+        os << "\"ns_per_op\": " << result.ns_per_op << ", ";
+        os << "\"heap_bytes_per_op\": " << result.heap_bytes_per_op << ", ";
+        os << "\"output_bytes_per_op\": " << result.output_bytes_per_op << ", ";
+        os << "\"instructions_per_op\": ";
+        if (result.instructions_per_op) {
+            os << *result.instructions_per_op;
+        }
+        else {
+            os << "null";
+        }
+        os << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    os << "  ]\n";
+    os << "}\n";
+}
+
+
+/**
+ * Usage: FormatBenchmark [results.json]
+ * The results are printed as a table, and written as JSON to the given file.
+ */
+int main(int argc, char** argv)
+{
+    // Always the same inputs, for comparable results between runs
+    std::mt19937_64 rng(42);
+
+    bench_decimal<int8_t>("%d int8", rng);
+    bench_decimal<int16_t>("%d int16", rng);
+    bench_decimal<int32_t>("%d int32", rng);
+    bench_decimal<int64_t>("%d int64", rng);
+    bench_decimal<uint64_t>("%d uint64", rng);
+    bench_hexadecimal<uint32_t>("%x uint32", rng);
+    bench_hexadecimal<uint64_t>("%x uint64", rng);
+    bench_float(rng);
+    bench_string<16>("%s 8 chars", rng, 8);
+    bench_string<256>("%s 200 chars", rng, 200);
+    bench_char(rng);
+    bench_mixed(rng);
+
+    print_table(std::cout);
+    if (!instruction_counter.available()) {
+        std::cout << "Instruction counts are unavailable (perf_event_open failed)\n";
+    }
+
+    if (argc > 1) {
+        std::ofstream file(argv[1]);
+        if (!file) {
+            std::cerr << "Could not open '" << argv[1] << "'\n";
+            return 1;
+        }
+        write_json(file);
+        std::cout << "Results written to '" << argv[1] << "'\n";
+    }
+
+    return 0;
+}
@@ -61,6 +61,34 @@ constexpr auto test_fmt = "%s world"sv;
 
 #define ONLY_COMPILE
 
+#elif TEST_NUMBER == 6
+
+// '%f' long double format, built without the GNU extensions
+constexpr auto test_fmt = "A long double: %f"sv;
+constexpr auto val_test = 0.5l;
+constexpr auto expected = "A long double: 0.5"sv;
+
+#elif TEST_NUMBER == 7
+
+// '%.3f' floating point format with a precision
+constexpr auto test_fmt = "A float: %.3f"sv;
+constexpr auto val_test = 2.0 / 3;
+constexpr auto expected = "A float: 0.667"sv;
+
+#elif TEST_NUMBER == 7
+
+// '%-4d' left aligned number with a width
+constexpr auto test_fmt = "[%-4d]"sv;
+constexpr auto val_test = 42;
+constexpr auto expected = "[42  ]"sv;
+
+#elif TEST_NUMBER == 8
+
+// '%'_12d' number grouped with a custom separator, with a width
+constexpr auto test_fmt = "[%'_12d]"sv;
+constexpr auto val_test = -1234567;
+constexpr auto expected = "[  -1_234_567]"sv;
+
 #else
 #error "Unknown test number: " TEST_NUMBER
 #endif
@@ -42,6 +42,31 @@ constexpr auto val_test = 42;
 constexpr auto test_fmt = ""sv;
 constexpr auto val_test = 42;
 
+#elif TEST_NUMBER == 4
+
+// Precision with a non floating point format
+constexpr auto test_fmt = "A number: %.3d"sv;
+constexpr auto val_test = 42;
+
+#elif TEST_NUMBER == 5
+
+// Missing precision after the '.'
+constexpr auto test_fmt = "A number: %.f"sv;
+constexpr auto val_test = 4.2;
+
+#elif TEST_NUMBER == 6
+
+// Span too small for the format
+constexpr auto test_fmt = "A number: %d"sv;
+constexpr auto val_test = 42;
+#define SPAN_SIZE 5
+
+#elif TEST_NUMBER == 7
+
+// Digit grouping with a non decimal format
+constexpr auto test_fmt = "A number: %'x"sv;
+constexpr auto val_test = 42;
+
 #else
 #warning "Unknown test number"
 // Valid format to make the test fail
@@ -52,7 +77,14 @@ constexpr auto val_test = 42;
 
 int main()
 {
+#ifdef SPAN_SIZE
+    char buffer[SPAN_SIZE];
+    constexpr auto fmt = cst_fmt::compile_format<test_fmt, std::remove_cv_t<decltype(val_test)>>();
+    const char* end = cst_fmt::format_to(fmt, std::span<char, SPAN_SIZE>(buffer), FORMAT_ARGS);
+    std::cout << std::string_view(buffer, end) << "\n";
+#else
     constexpr auto str = cst_fmt::format<test_fmt>(FORMAT_ARGS);
     std::cout << str << "\n";
+#endif
     return 0;
 }
@@ -3,7 +3,11 @@
 #define CONSTEXPRFORMAT_CONST_FORMAT_H
 
 
+#include <algorithm>
 #include <array>
+#include <iterator>
+#include <span>
+#include <ranges>
 #include <type_traits>
 #include <concepts>
 #include <limits>
@@ -11,11 +15,36 @@
 #include <tuple>
 #include <cstddef>
 #include <cstdint>
-#include <cmath>
+#include <cstring>
 #include <string_view>
 #include <string>
 #include <ostream>
 
+#if defined(__AVX2__) || defined(__BMI2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace cst_fmt
+{
+    /**
+     * What to do when a dynamic string is longer than the maximum length of its holder.
+     */
+    enum class Truncation
+    {
+        // Copy the first N characters
+        silent,
+        // Copy the first N characters, the last three replaced by "..."
+        ellipsis,
+        // Copy the first N characters, and set the truncation flag of the resulting string
+        report
+    };
+}
+
 
 namespace cst_fmt::utils
 {
@@ -48,11 +77,12 @@ namespace cst_fmt::utils
 	};
 	
 	
-	template<size_t N>
+	template<size_t N, Truncation policy>
 	struct DynStrHolder
 	{
 		static constexpr bool _is_dyn_str_holder = true;
 		static constexpr size_t size() { return N; }
+		static constexpr Truncation truncation() { return policy; }
 
 		const char* str;
 	};
@@ -62,8 +92,128 @@ namespace cst_fmt::utils
 	concept is_dyn_str_holder = requires {
 		T::_is_dyn_str_holder == true;
 	};
+
+	
+	template<size_t N, Truncation policy>
+	struct DynStrViewHolder
+	{
+		static constexpr bool _is_dyn_str_view_holder = true;
+		static constexpr size_t size() { return N; }
+		static constexpr Truncation truncation() { return policy; }
+
+		std::string_view str;
+	};
+	
+	
+	template<typename T>
+	concept is_dyn_str_view_holder = requires {
+		T::_is_dyn_str_view_holder == true;
+	};
+
+
+
+    /**
+     *  Sets the truncation flag of the formatted string, if it has one.
+     */
+    template<typename Str>
+    constexpr void report_truncation(Str& str)
+    {
+        if constexpr (requires { str.set_truncated(); }) {
+            str.set_truncated();
+        }
+    }
+
+
+    /**
+     *  Prepares a buffer declared without initializer: its characters are only zeroed in constant evaluation, where
+     *  all of them must be initialized, or if 'CONSTEXPRFORMAT_ZERO_INIT' is defined. Otherwise, the characters past
+     *  the ones written are unspecified.
+     */
+    template<typename Str>
+    constexpr void init_buffer(Str& str)
+    {
+#ifndef CONSTEXPRFORMAT_ZERO_INIT
+        if (!std::is_constant_evaluated()) {
+            return;
+        }
+#endif
+        str.fill('\0');
+    }
+
+
+    /**
+     *  Applies the truncation policy to the N characters of a dynamic string copied at 'pos'.
+     */
+    template<Truncation policy, size_t N, typename Str>
+    constexpr void apply_truncation(Str& str, size_t pos, bool truncated)
+    {
+        if constexpr (policy == Truncation::ellipsis) {
+            constexpr size_t dots = N < 3 ? N : 3;
+            if (truncated) {
+                for (size_t i = N - dots; i < N; i++) {
+                    str[pos + i] = '.';
+                }
+            }
+        }
+        else if constexpr (policy == Truncation::report) {
+            if (truncated) {
+                report_truncation(str);
+            }
+        }
+    }
 	
 
+#if defined(__AVX2__) || defined(__SSE2__)
+    /**
+     *  Returns a mask of the '\0' characters in the block of characters starting at 'block', at any alignment.
+     */
+    inline uint32_t block_zero_mask(const char* block)
+    {
+#if defined(__AVX2__)
+        const __m256i chars = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(block));
+        return uint32_t(_mm256_movemask_epi8(_mm256_cmpeq_epi8(chars, _mm256_setzero_si256())));
+#else
+        const __m128i chars = _mm_loadu_si128(reinterpret_cast<const __m128i*>(block));
+        return uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(chars, _mm_setzero_si128())));
+#endif
+    }
+#endif
+
+
+    /**
+     *  Returns the position of the first '\0' in the first N characters of 'str', or N if there is none.
+     *  Not usable in constant expressions.
+     *
+     *  All N characters must be readable, even past the '\0', and nothing outside of them is read: the full blocks of
+     *  them are compared at once, and the remaining 'N % block_size' characters (all of them without SSE2) are
+     *  searched with 'memchr'.
+     */
+    template<size_t N>
+    inline size_t bounded_str_length(const char* str)
+    {
+        size_t length = 0;
+#if defined(__AVX2__) || defined(__SSE2__)
+#if defined(__AVX2__)
+        constexpr size_t block_size = sizeof(__m256i);
+#else
+        constexpr size_t block_size = sizeof(__m128i);
+#endif
+        for (; length + block_size <= N; length += block_size) {
+            const uint32_t mask = block_zero_mask(str + length);
+            if (mask != 0) {
+                return length + std::countr_zero(mask);
+            }
+        }
+#endif
+        if (length == N) {
+            return N;
+        }
+        // 'memchr' stops at the first match, and is vectorised by most C libraries
+        const void* end = std::memchr(str + length, '\0', N - length);
+        return end != nullptr ? size_t(static_cast<const char*>(end) - str) : N;
+    }
+
+
     template<typename T>
     concept is_const_iterable = requires (const T& val) {
         val.cbegin();
@@ -73,305 +223,2162 @@ namespace cst_fmt::utils
 
 
     /**
-     *  Returns the number of decimal digits needed to represent the given number.
+     *  True for unsigned integral types, including 'unsigned __int128' even without the GNU extensions, where the
+     *  standard traits reject it.
      */
     template<typename T>
-    constexpr uint32_t decimal_digits_count(T x)
+    inline constexpr bool is_unsigned_integral_v = (std::is_integral_v<T> && std::is_unsigned_v<T>)
+#ifdef __SIZEOF_INT128__
+                                                   || std::same_as<T, unsigned __int128>
+#endif
+                                                   ;
+
+
+    /**
+     *  Same as 'std::bit_width', but also accepts 'unsigned __int128', with its two 64-bit halves.
+     */
+    template<typename T>
+    constexpr uint32_t bit_width(T x)
     {
-        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "The argument must be an unsigned integral");
-        uint32_t i = 0;
-        while (x > 0) {
-            x /= 10;
-            i++;
+        static_assert(is_unsigned_integral_v<T>, "The argument must be an unsigned integral");
+        if constexpr (sizeof(T) > sizeof(uint64_t)) {
+            const auto high = uint64_t(x >> 64);
+            return high != 0 ? 64 + uint32_t(std::bit_width(high)) : uint32_t(std::bit_width(uint64_t(x)));
+        }
+        else {
+            return uint32_t(std::bit_width(x));
         }
-        return i;
     }
 
 
+    /**
+     *  The smallest unsigned integer type which can hold all values up to N, with its highest bit left unused.
+     */
+    template<size_t N>
+    using small_size_t = std::conditional_t<(N < (size_t(1) << 7)), uint8_t,
+                         std::conditional_t<(N < (size_t(1) << 15)), uint16_t,
+                         std::conditional_t<(N < (size_t(1) << 31)), uint32_t, uint64_t>>>;
+
+
     /**
      *  Returns the number of decimal digits needed to represent the given number in hexadecimal.
      */
     template<typename T>
     constexpr uint32_t hexadecimal_digits_count(T x)
     {
-        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "The argument must be an unsigned integral");
-        uint32_t count = std::bit_width(x);
+        static_assert(is_unsigned_integral_v<T>, "The argument must be an unsigned integral");
+        uint32_t count = bit_width(x);
         return count / 4 + (count % 4 == 0 ? 0 : 1);
     }
 
 
     /**
-     *  Returns 16^p. Integers only.
+     *  Two hexadecimal digits for each byte value: the digits of 'n' are at indexes 2n and 2n+1.
+     */
+    inline constexpr char hex_digit_pairs[513] =
+        "000102030405060708090A0B0C0D0E0F101112131415161718191A1B1C1D1E1F"
+        "202122232425262728292A2B2C2D2E2F303132333435363738393A3B3C3D3E3F"
+        "404142434445464748494A4B4C4D4E4F505152535455565758595A5B5C5D5E5F"
+        "606162636465666768696A6B6C6D6E6F707172737475767778797A7B7C7D7E7F"
+        "808182838485868788898A8B8C8D8E8F909192939495969798999A9B9C9D9E9F"
+        "A0A1A2A3A4A5A6A7A8A9AAABACADAEAFB0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+        "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECFD0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+        "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEFF0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+
+    /**
+     *  Writes exactly 'digits' hexadecimal digits of 'val' at 'pos', padded with leading zeros.
      */
-    template<typename R, typename T>
-    constexpr R const_16_pow(T p)
+    template<typename Str, typename T>
+    constexpr void write_hex_digits(Str& str, size_t pos, T val, uint32_t digits)
     {
-        static_assert(std::is_integral_v<T> && std::is_unsigned_v<T>, "The argument must be an unsigned integral");
-        if (p == 0) {
-            return 1;
+        while (digits >= 2) {
+            const auto pair = 2 * uint32_t(val & 0xFF);
+            val >>= 8;
+            digits -= 2;
+            str[pos + digits] = hex_digit_pairs[pair];
+            str[pos + digits + 1] = hex_digit_pairs[pair + 1];
         }
-        else {
-            return R(16) << (4 * (p - 1));
+        if (digits > 0) {
+            str[pos] = hex_digit_pairs[2 * uint32_t(val & 0xF) + 1];
         }
     }
 
-    
+
     /**
-     *  Converts the given number to characters in base 10.
-     *  If 'ignore_trailing_zeros' is true, zeros at the end of the number will not be written.
+     *  Writes the 16 hexadecimal digits of 'val' to 'out', most significant first. Not usable in constant expressions.
      */
-    template<bool ignore_trailing_zeros = false, size_t N, typename T>
-    constexpr void int_to_char_array(std::array<char, N>& str, size_t& pos, const T& val)
+    inline void hex_u64_to_chars(char* out, uint64_t val)
     {
-        typedef typename std::make_unsigned<T>::type uT;
-        uT u_val = val;
+#if defined(__SSSE3__)
+        // Reverse the bytes and spread each nibble to its own byte, then map them to characters with one shuffle
+        const __m128i nibble_mask = _mm_set1_epi8(0x0F);
+        const __m128i reverse = _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, -1, -1, -1, -1, -1, -1, -1, -1);
+        const __m128i digits = _mm_setr_epi8('0', '1', '2', '3', '4', '5', '6', '7',
+                                             '8', '9', 'A', 'B', 'C', 'D', 'E', 'F');
+        const __m128i bytes = _mm_shuffle_epi8(_mm_cvtsi64_si128(static_cast<long long>(val)), reverse);
+        const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), nibble_mask);
+        const __m128i low = _mm_and_si128(bytes, nibble_mask);
+        const __m128i chars = _mm_shuffle_epi8(digits, _mm_unpacklo_epi8(high, low));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+#else
+        // SWAR: spread each nibble of a 32-bit half to its own byte, then convert all 8 bytes at once.
+        // 'nibble >= 10' is detected by the carry of 'nibble + 6' into the upper half of the byte.
+        const auto convert_half = [](uint32_t half) {
+            uint64_t x = half;
+            x = (x | (x << 16)) & 0x0000FFFF0000FFFFull;
+            x = (x | (x << 8)) & 0x00FF00FF00FF00FFull;
+            x = (x | (x << 4)) & 0x0F0F0F0F0F0F0F0Full;
+            const uint64_t letters = ((x + 0x0606060606060606ull) >> 4) & 0x0101010101010101ull;
+            x += 0x3030303030303030ull + letters * ('A' - '9' - 1);
+            // The least significant nibble is now in the first byte, which must be written last
+            if constexpr (std::endian::native == std::endian::little) {
+                x = ((x & 0x00000000FFFFFFFFull) << 32) | ((x & 0xFFFFFFFF00000000ull) >> 32);
+                x = ((x & 0x0000FFFF0000FFFFull) << 16) | ((x & 0xFFFF0000FFFF0000ull) >> 16);
+                x = ((x & 0x00FF00FF00FF00FFull) << 8) | ((x & 0xFF00FF00FF00FF00ull) >> 8);
+            }
+            return x;
+        };
+        const uint64_t high = convert_half(uint32_t(val >> 32));
+        const uint64_t low = convert_half(uint32_t(val));
+        std::memcpy(out, &high, sizeof(high));
+        std::memcpy(out + sizeof(high), &low, sizeof(low));
+#endif
+    }
 
-        if constexpr (std::is_signed_v<T>) {
-    		if (val < 0) {
-    			str[pos++] = '-';
-                u_val = -val;
-    		}
-    	}
 
-        uint32_t val_digits = 1;
+    /**
+     *  Returns the bytes of 'x' in the reverse order. Compilers turn this into a single instruction.
+     */
+    constexpr uint64_t reverse_bytes(uint64_t x)
+    {
+        x = ((x & 0x00000000FFFFFFFFull) << 32) | ((x & 0xFFFFFFFF00000000ull) >> 32);
+        x = ((x & 0x0000FFFF0000FFFFull) << 16) | ((x & 0xFFFF0000FFFF0000ull) >> 16);
+        x = ((x & 0x00FF00FF00FF00FFull) << 8) | ((x & 0xFF00FF00FF00FF00ull) >> 8);
+        return x;
+    }
+
 
-        if (u_val != 0 && u_val != 1) {
-            val_digits += std::floor(std::log10(u_val));
+    /**
+     *  Writes exactly 'digits' binary digits of 'val' at 'pos', padded with leading zeros.
+     */
+    template<typename Str, typename T>
+    constexpr void write_binary_digits(Str& str, size_t pos, T val, uint32_t digits)
+    {
+        while (digits > 0) {
+            digits--;
+            str[pos + digits] = char('0' + (val & 1));
+            val >>= 1;
         }
+    }
 
-        uT a = std::pow(10, val_digits - 1);
-
-        for (uint32_t i = 0; i < val_digits; i++) {
-            str[pos++] = '0' + (u_val / a);
-            u_val = u_val % a;
-            a /= 10;
 
-            if constexpr (ignore_trailing_zeros) {
-                if (u_val == 0) {
-                    break;
-                }
+    /**
+     *  Writes the 64 binary digits of 'val' to 'out', most significant first. Not usable in constant expressions.
+     */
+    inline void binary_u64_to_chars(char* out, uint64_t val)
+    {
+#if defined(__SSSE3__)
+        // Broadcast each byte to 8 lanes, most significant first, then test a different bit in each lane
+        const __m128i bytes = _mm_cvtsi64_si128(static_cast<long long>(val));
+        const __m128i bits = _mm_setr_epi8(char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01,
+                                           char(0x80), 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01);
+        const __m128i zeros = _mm_set1_epi8('0');
+        for (int i = 0; i < 4; i++) {
+            const char high = char(7 - 2 * i);
+            const char low = char(6 - 2 * i);
+            const __m128i spread = _mm_shuffle_epi8(bytes, _mm_setr_epi8(high, high, high, high, high, high, high, high,
+                                                                         low, low, low, low, low, low, low, low));
+            // Set lanes are -1: subtracting them from '0' gives '1'
+            const __m128i set = _mm_cmpeq_epi8(_mm_and_si128(spread, bits), bits);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 16 * i), _mm_sub_epi8(zeros, set));
+        }
+#else
+        for (int i = 0; i < 8; i++) {
+            const uint64_t byte = (val >> (56 - 8 * i)) & 0xFF;
+#if defined(__BMI2__) && defined(__x86_64__)
+            // Each bit to the lowest bit of its own byte, the least significant in the first byte
+            uint64_t x = _pdep_u64(byte, 0x0101010101010101ull);
+            if constexpr (std::endian::native == std::endian::little) {
+                x = reverse_bytes(x);
             }
+#else
+            // SWAR: copy the byte to all 8 bytes, keep a different bit in each, then move it to the lowest bit.
+            // The most significant bit is kept in the byte written first.
+            constexpr uint64_t bit_masks = std::endian::native == std::endian::little ? 0x0102040810204080ull
+                                                                                        : 0x8040201008040201ull;
+            uint64_t x = (byte * 0x0101010101010101ull) & bit_masks;
+            x = ((x + 0x7F7F7F7F7F7F7F7Full) >> 7) & 0x0101010101010101ull;
+#endif
+            x += 0x3030303030303030ull;
+            std::memcpy(out + 8 * i, &x, sizeof(x));
         }
+#endif
     }
-}
 
 
-namespace cst_fmt
-{
     /**
-     * A simple struct holding reusable information for a format.
+     *  Writes exactly 'digits' octal digits of 'val' at 'pos', padded with leading zeros.
      */
-    template<const std::string_view& fmt, const size_t N>
-    struct CompiledFormat
+    template<typename Str, typename T>
+    constexpr void write_octal_digits(Str& str, size_t pos, T val, uint32_t digits)
     {
-        [[nodiscard]]
-        static constexpr const std::string_view& get_fmt() { return fmt; }
-
-        [[nodiscard]]
-        static constexpr size_t get_str_size() { return N; }
-    };
+        while (digits > 0) {
+            digits--;
+            str[pos + digits] = char('0' + (val & 7));
+            val >>= 3;
+        }
+    }
 
 
     /**
-     * A constant size, string-like object.
+     *  Writes the 24 octal digits of 'val' to 'out' (the first two are always '0'), most significant first.
+     *  Not usable in constant expressions.
      */
-    template<size_t N>
-    class FormattedCharArray : public std::array<char, N>
+    inline void octal_u64_to_chars(char* out, uint64_t val)
     {
-        size_t m_effective_size;
-
-    public:
-        using std::array<char, N>::data;
-
-        constexpr void set_effective_size(size_t effective_size) { m_effective_size = effective_size; }
-
-        [[nodiscard]]
-        constexpr size_t effective_size() const { return m_effective_size; }
+        // Each block of 24 bits gives 8 digits
+        for (int i = 0; i < 3; i++) {
+            const uint64_t block = (val >> (48 - 24 * i)) & 0xFFFFFF;
+#if defined(__BMI2__) && defined(__x86_64__)
+            // Each digit to its own byte, the least significant in the first byte
+            uint64_t x = _pdep_u64(block, 0x0707070707070707ull);
+#else
+            // SWAR: split the block in halves until each digit is in its own byte
+            uint64_t x = block;
+            x = (x | (x << 20)) & 0x00000FFF00000FFFull;
+            x = (x | (x << 10)) & 0x003F003F003F003Full;
+            x = (x | (x << 5)) & 0x0707070707070707ull;
+#endif
+            if constexpr (std::endian::native == std::endian::little) {
+                x = reverse_bytes(x);
+            }
+            x += 0x3030303030303030ull;
+            std::memcpy(out + 8 * i, &x, sizeof(x));
+        }
+    }
 
-        [[nodiscard]]
-        constexpr const char* cstr() const { return data(); }
 
-        [[nodiscard]]
-        constexpr std::string_view view() const { return std::string_view(data(), m_effective_size); }
+    /**
+     *  Two decimal digits for each number from 0 to 99: the digits of 'n' are at indexes 2n and 2n+1.
+     */
+    inline constexpr char digit_pairs[201] =
+        "0001020304050607080910111213141516171819"
+        "2021222324252627282930313233343536373839"
+        "4041424344454647484950515253545556575859"
+        "6061626364656667686970717273747576777879"
+        "8081828384858687888990919293949596979899";
 
 
-        [[nodiscard]]
-#ifndef __clang__
-        // Clang doesn't support constexpr string constructors for now
-        constexpr
-#endif
-        std::string str() const { return std::string(data(), m_effective_size + 1); }
+    /**
+     *  Each number from 0 to 999 as three decimal digits preceded by the separator: the characters of 'n' are at
+     *  indexes 4n to 4n+3, copied at once.
+     */
+    template<char separator>
+    inline constexpr auto separated_digit_triples = [] {
+        std::array<char, 4000> table{};
+        for (size_t n = 0; n < 1000; n++) {
+            table[4 * n] = separator;
+            table[4 * n + 1] = char('0' + n / 100);
+            table[4 * n + 2] = char('0' + n / 10 % 10);
+            table[4 * n + 3] = char('0' + n % 10);
+        }
+        return table;
+    }();
 
 
-        template<typename T>
-            requires utils::is_const_iterable<T>
-        constexpr bool operator==(const T& array) const
-        {
-            if (m_effective_size != array.size()) {
-                return false;
-            }
-            // We iterate on the other array since our array size is bigger than the effective size
-            return std::equal(array.cbegin(), array.cend(), this->cbegin());
+    /**
+     *  All powers of ten representable by the unsigned integral type T: 'pow10_table<T>[i] == 10^i'.
+     */
+    template<typename T>
+    inline constexpr auto pow10_table = [] {
+        std::array<T, std::numeric_limits<T>::digits10 + 1> table{};
+        T p = 1;
+        for (T& v : table) {
+            v = p;
+            p *= 10;
         }
+        return table;
+    }();
 
 
-        template<typename T>
-            requires utils::is_const_iterable<T>
-        constexpr bool operator!=(const T& array) const
-        {
-            if (m_effective_size != array.size()) {
-                return true;
+    /**
+     *  Returns the number of decimal digits needed to represent the given number.
+     */
+    template<typename T>
+    constexpr uint32_t decimal_digits_count(T x)
+    {
+        static_assert(is_unsigned_integral_v<T>, "The argument must be an unsigned integral");
+        if constexpr (sizeof(T) < sizeof(uint32_t)) {
+            return decimal_digits_count(uint32_t(x));
+        }
+        else if constexpr (sizeof(T) > sizeof(uint64_t)) {
+            if (x > std::numeric_limits<uint64_t>::max()) {
+                return 19 + decimal_digits_count(T(x / pow10_table<uint64_t>[19]));
             }
-            // We iterate on the other array since our array size is bigger than the effective size
-            return !std::equal(array.cbegin(), array.cend(), this->cbegin());
+            return decimal_digits_count(uint64_t(x));
         }
-    };
+        else {
+            // log10(2) ~= 1233 / 2^12, which gives either the exact digit count or one too many
+            const uint32_t approx = (bit_width(x) * 1233) >> 12;
+            return approx + 1 - (x < pow10_table<T>[approx]);
+        }
+    }
 
 
-    template<size_t N>
-    std::ostream& operator<<(std::ostream& os, const FormattedCharArray<N>& str)
+    /**
+     *  Writes exactly 'digits' decimal digits of 'val' at 'pos', padded with leading zeros.
+     */
+    template<typename Str, typename T>
+    constexpr void write_decimal_digits(Str& str, size_t pos, T val, uint32_t digits)
     {
-        os << str.view();
-        return os;
+        while (digits >= 2) {
+            const auto pair = 2 * uint32_t(val % 100);
+            val /= 100;
+            digits -= 2;
+            str[pos + digits] = digit_pairs[pair];
+            str[pos + digits + 1] = digit_pairs[pair + 1];
+        }
+        if (digits > 0) {
+            str[pos] = char('0' + val);
+        }
     }
-}
 
 
-/*
- * Additional formats can be specified here by using the same structure.
- */
-namespace cst_fmt::specialisation
-{
-	//
-	// %d -> decimal number
-	//
-	
-	
-	template<char fmt>
-	concept decimal_format = fmt == 'd';
-	
-	
-    template<char fmt, typename T>
-    	requires decimal_format<fmt> && std::is_integral_v<T>
-    consteval size_t formatted_str_length()
+    /**
+     *  Writes all decimal digits of the given unsigned number, without leading zeros.
+     */
+    template<typename Str, typename T>
+    constexpr void unsigned_to_char_array(Str& str, size_t& pos, T val)
     {
-        if constexpr (std::is_signed_v<T>) {
-            // Add one space for a potential minus sign
-            return std::numeric_limits<T>::digits10 + 2;
+        if constexpr (sizeof(T) < sizeof(uint32_t)) {
+            // Smaller types are promoted to avoid casts at each step
+            unsigned_to_char_array(str, pos, uint32_t(val));
+        }
+        else if constexpr (sizeof(T) > sizeof(uint64_t)) {
+            // Split wide numbers into chunks of 19 digits, so that most of the work is done with native integers
+            if (val > std::numeric_limits<uint64_t>::max()) {
+                constexpr uint64_t chunk = pow10_table<uint64_t>[19];
+                unsigned_to_char_array(str, pos, T(val / chunk));
+                write_decimal_digits(str, pos, uint64_t(val % chunk), 19);
+                pos += 19;
+            }
+            else {
+                unsigned_to_char_array(str, pos, uint64_t(val));
+            }
         }
         else {
-            return std::numeric_limits<T>::digits10 + 1;
+            const uint32_t digits = val == 0 ? 1 : decimal_digits_count(val);
+            write_decimal_digits(str, pos, val, digits);
+            pos += digits;
         }
     }
 
-
-    template<char fmt, typename T>
-    	requires decimal_format<fmt> && (!std::is_integral_v<T>)
-    consteval size_t formatted_str_length()
+    
+    /**
+     *  Converts the given number to characters in base 10.
+     */
+    template<typename Str, typename T>
+    constexpr void int_to_char_array(Str& str, size_t& pos, const T& val)
     {
-        static_assert(fmt == '\0', "'%d' expected an integral type");
-        return 0;
+        typedef typename std::make_unsigned<T>::type uT;
+        uT u_val = val;
+
+        if constexpr (std::is_signed_v<T>) {
+            // The negation is done on the unsigned type, since '-val' overflows for the most negative value
+            const bool negative = val < 0;
+            str[pos] = '-'; // Overwritten by the first digit if the value is positive
+            pos += negative;
+            u_val = negative ? uT(uT(0) - u_val) : u_val;
+    	}
+
+        unsigned_to_char_array(str, pos, u_val);
     }
 
 
-    template<char fmt, size_t N, typename T>
-    	requires decimal_format<fmt> && std::is_integral_v<T> && (!std::same_as<T, bool>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, T val)
+    /**
+     *  Returns the number of separators between the groups of three digits of a number of 'digits' digits.
+     */
+    constexpr uint32_t digit_groups_separators(uint32_t digits)
     {
-        utils::int_to_char_array(str, pos, val);
+        return (digits - 1) / 3;
     }
 
 
-    template<char fmt, size_t N, typename T>
-     	requires decimal_format<fmt> && std::is_integral_v<T> && std::same_as<T, bool>
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+    /**
+     *  Converts the given number to characters in base 10, with the separator between each group of three digits.
+     */
+    template<char separator, typename Str, typename T>
+    constexpr void grouped_int_to_char_array(Str& str, size_t& pos, const T& val)
     {
-        str[pos++] = val ? '1' : '0';
+        typedef typename std::make_unsigned<T>::type uT;
+        // Smaller types are promoted to avoid casts at each step
+        typedef std::conditional_t<(sizeof(uT) < sizeof(uint32_t)), uint32_t, uT> U;
+        U u_val = uT(val);
+
+        if constexpr (std::is_signed_v<T>) {
+            const bool negative = val < 0;
+            str[pos] = '-';
+            pos += negative;
+            u_val = negative ? U(uT(uT(0) - uT(val))) : u_val;
+        }
+
+        const uint32_t digits = u_val == 0 ? 1 : decimal_digits_count(u_val);
+        const uint32_t groups = digit_groups_separators(digits);
+
+        // The groups are written from the last one, each with the separator before it.
+        // Types of 3 digits or less never have any, and their buffer has no room for one.
+        if constexpr (std::numeric_limits<T>::digits10 / 3 > 0) {
+            size_t group_pos = pos + digits + groups;
+            for (uint32_t i = 0; i < groups; i++) {
+                const auto triple = 4 * size_t(u_val % 1000);
+                u_val /= 1000;
+                group_pos -= 4;
+                if (std::is_constant_evaluated()) {
+                    for (size_t j = 0; j < 4; j++) {
+                        str[group_pos + j] = separated_digit_triples<separator>[triple + j];
+                    }
+                }
+                else {
+                    std::memcpy(&str[group_pos], separated_digit_triples<separator>.data() + triple, 4);
+                }
+            }
+        }
+
+        // The leading group of 1 to 3 digits
+        write_decimal_digits(str, pos, u_val, digits - 3 * groups);
+        pos += digits + groups;
     }
-    
-    
-    template<char fmt, size_t N, typename T>
-     	requires decimal_format<fmt> && (!std::is_integral_v<T>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+
+
+    /**
+     *  Returns the low 64 bits of 'a * b', and stores the high 64 bits in 'high'.
+     */
+    constexpr uint64_t umul128(uint64_t a, uint64_t b, uint64_t& high)
     {
-    	static_assert(fmt == '\0', "'%d' expected an integral type");
+#ifdef __SIZEOF_INT128__
+        const unsigned __int128 r = static_cast<unsigned __int128>(a) * b;
+        high = uint64_t(r >> 64);
+        return uint64_t(r);
+#else
+        const uint64_t a_lo = uint32_t(a), a_hi = a >> 32;
+        const uint64_t b_lo = uint32_t(b), b_hi = b >> 32;
+        const uint64_t lo_lo = a_lo * b_lo, hi_lo = a_hi * b_lo, lo_hi = a_lo * b_hi, hi_hi = a_hi * b_hi;
+        const uint64_t cross = (lo_lo >> 32) + uint32_t(hi_lo) + lo_hi;
+        high = hi_hi + (hi_lo >> 32) + (cross >> 32);
+        return (cross << 32) | uint32_t(lo_lo);
+#endif
     }
-    
-    
+
+
+    /**
+     *  Multiplies two integers stored as arrays of 64-bit limbs, least significant limb first.
+     */
+    template<size_t NA, size_t NB>
+    constexpr std::array<uint64_t, NA + NB> mul_limbs(const std::array<uint64_t, NA>& a, const std::array<uint64_t, NB>& b)
+    {
+        std::array<uint64_t, NA + NB> r{};
+        for (size_t j = 0; j < NB; j++) {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < NA; i++) {
+                // r[i + j] + a[i] * b[j] + carry always fits in 128 bits
+                uint64_t high;
+                uint64_t low = umul128(a[i], b[j], high);
+                low += r[i + j];
+                high += low < r[i + j];
+                low += carry;
+                high += low < carry;
+                r[i + j] = low;
+                carry = high;
+            }
+            r[j + NA] = carry;
+        }
+        return r;
+    }
+
+
+    /**
+     *  floor(log10(2^e)), exact for |e| <= 17000.
+     */
+    constexpr int32_t floor_log10_pow2(int32_t e)
+    {
+        return int32_t((int64_t(e) * 20201781) >> 26);
+    }
+
+
+    /**
+     *  floor(log10(3/4 * 2^e)), exact for |e| <= 17000.
+     */
+    constexpr int32_t floor_log10_three_quarters_pow2(int32_t e)
+    {
+        return int32_t((int64_t(e) * 20201781 - 8384494) >> 26);
+    }
+
+
+    /**
+     *  floor(log2(10^e)), exact for |e| <= 5200.
+     */
+    constexpr int32_t floor_log2_pow10(int32_t e)
+    {
+        return int32_t((int64_t(e) * 55732705) >> 24);
+    }
+
+
+    /**
+     *  Decimal exponent of the first entry of 'pow10_significands', and the exponent step between two entries.
+     */
+    inline constexpr int32_t pow10_significands_min_exponent = -4914;
+    inline constexpr int32_t pow10_significands_step = 27;
+
+
+    /**
+     *  The significand of 10^e rounded up to 192 bits, for e = -4914 + 27i:
+     *  floor(10^e * 2^(191 - floor_log2_pow10(e))) + 1, least significant limb first.
+     *  The range of exponents covers all floating point types up to the 80-bit x87 long double.
+     */
+    inline constexpr uint64_t pow10_significands[366][3] = {
+        { 0x10F6F58CCBB9BA9Aull, 0xAFA295F98DDEC8E0ull, 0x841633EEB6E594A8ull },
+        { 0x25073C62D39466B3ull, 0xF0B0D335219D00B1ull, 0xD565CA8493A376ABull },
+        { 0xD9B00D4AD580A853ull, 0x406F2E0B6AFC6E64ull, 0xAC61980370104339ull },
+        { 0xBF8C82E43723966Aull, 0x9588EE60EEFEF708ull, 0x8B3F9A1BBA11A273ull },
+        { 0xB39E1CBCD18642B2ull, 0xFB555D87EB5FDB01ull, 0xE0F7CE9F8C8D85F7ull },
+        { 0x9EF9EA675A6DE800ull, 0xA2708AE3C0E59D27ull, 0xB5BA4A92C4524D23ull },
+        { 0xFC1204076D70970Cull, 0x05A381BCECFF3F05ull, 0x92CC685AA8B19088ull },
+        { 0x3DA563D1BCF2E89Dull, 0x4774A69ADDF3C50Dull, 0xED2A6C4D961CCDC9ull },
+        { 0x59694B4D86806CBAull, 0xD02D9D420B17949Bull, 0xBF94B86A06712FBDull },
+        { 0x271D67E7128014A4ull, 0x07D6C3F803AD0E54ull, 0x9AC20275869F3FADull },
+        { 0x1A70689560F9778Cull, 0xE4E4E3B1AF719DC5ull, 0xFA0658BA18106ED7ull },
+        { 0xFEA3C633F1DAC0E2ull, 0xF2A3D9BF4E810613ull, 0xC9F7EA3EABE3223Full },
+        { 0x126E228268437F85ull, 0xFA3FE8BB95311DEDull, 0xA32617062F3A5A7Full },
+        { 0xFCC8686B02720AB2ull, 0x81103DF5BA944369ull, 0x83CA60F6F9271AD4ull },
+        { 0x451E855D8ACEF836ull, 0x9E601E707A2C3488ull, 0xD4EB4A687C0253E8ull },
+        { 0x23D262205306CD7Eull, 0xD40D5AD2E69EF7B7ull, 0xABFEA384BE17D58Cull },
+        { 0xED2903F7E1DF2B79ull, 0xC846664FE1364EE8ull, 0x8AEFAAAE9060380Full },
+        { 0x26F5F1F177BE0CEBull, 0x44C0F1CD48C68252ull, 0xE076AA2CBFE4831Cull },
+        { 0x3070A8CB30764003ull, 0x532382326153CF39ull, 0xB551F88E45162E18ull },
+        { 0x3196140909048810ull, 0x9815890F2E69B32Aull, 0x92782367AAA5CDE1ull },
+        { 0xEB2CE0C9BAEA67A2ull, 0xB8DD884276053D26ull, 0xECA24752EC8DC779ull },
+        { 0xF5082AAE429013DEull, 0x6F14F59E4AC24462ull, 0xBF26BE66DD54290Dull },
+        { 0xBB9EFF7A25C44472ull, 0x8389C148C919653Aull, 0x9A692BD43B368FC3ull },
+        { 0x868AB2AFEA10D02Eull, 0x77BA14DB842D8AEDull, 0xF976D206C36354EDull },
+        { 0xBCF5A8B2982C07BFull, 0xDD8557BD67B5BD23ull, 0xC983F9BA4AE72226ull },
+        { 0x8D9B7486588E4506ull, 0x0A93070A0B55722Dull, 0xA2C86F4B1AC4847Dull },
+        { 0x1DA643862E46E868ull, 0xA670FEA2B9693A88ull, 0x837EB9860E07B1A6ull },
+        { 0x7433E64C4476D080ull, 0x2C6612B0049DD078ull, 0xD471109E97D96D9Bull },
+        { 0x3D237E4ED7E6DDF2ull, 0x5C44FEE4FBAD959Eull, 0xAB9BE7D41C0BDD34ull },
+        { 0x56C44CF8755CE78Aull, 0x9A4A665B9621795Aull, 0x8A9FE92462A9AD0Bull },
+        { 0xCB79E2722C1823B1ull, 0xEEB022F7D411A513ull, 0xDFF5CFDC3A10C7CBull },
+        { 0xF96467AA1A28D45Dull, 0xC8AF9C0864090E93ull, 0xB4E9E26C4D7C913Aull },
+        { 0x30DE69AD373E4148ull, 0x12DA77F02F6BE1D1ull, 0x92240ED493DD403Bull },
+        { 0xC10DF4F7163E8BDBull, 0x8C496BF82C48E6E7ull, 0xEC1A707F8961ECE4ull },
+        { 0x2E66F95957D0A340ull, 0x0CD48C4203456F3Full, 0xBEB9038573B3E305ull },
+        { 0x26E721B524DB450Aull, 0xE1A12638F79FA09Cull, 0x9A1088324AF4CF1Cull },
+        { 0x141940BFC9076094ull, 0xF3CF918A9131BC51ull, 0xF8E79DB77F6CA6B8ull },
+        { 0x237FE2507774567Eull, 0xB6A40B9B5C85A80Bull, 0xC9104BC3F2C9EE87ull },
+        { 0x7E14918A782FD122ull, 0xE19F7154AFE4A693ull, 0xA26AFD533D4AB9BFull },
+        { 0xA34ADA2A2E1E0C87ull, 0xD8C2D9B9D2228A26ull, 0x83333D82F9042320ull },
+        { 0x99C580D4B66DBB6Cull, 0x914E1E1ECCE62C87ull, 0xD3F71CFE89092EDFull },
+        { 0xD5D00508CBCBE85Aull, 0xCEE778EDF94BD423ull, 0xAB3964D0EE15BA74ull },
+        { 0xC4680D187059864Bull, 0x268889F30FC7A120ull, 0x8A505562D9997D8Aull },
+        { 0x63C6208B79D5D9E8ull, 0x140CB5AB8ED8DDD1ull, 0xDF753F836CA259FDull },
+        { 0xCD6412B24967664Dull, 0xF2129D39DA3420A5ull, 0xB482080A7D109C56ull },
+        { 0x6590F4EA15580468ull, 0xC90B388939A3C25Full, 0x91D02A859F642A16ull },
+        { 0x6FB070FBC9D09C15ull, 0xB3C8E4D4383AE332ull, 0xEB92E7A68F778FD1ull },
+        { 0x95CBC42F707651D3ull, 0x1EED66FA310B3384ull, 0xBE4B87A18BF2D338ull },
+        { 0x85FF7561F6A627FDull, 0x1402376A226EA133ull, 0x99B817726F741856ull },
+        { 0x28D55C87209F55F2ull, 0x0482159B8B70733Aull, 0xF858BB9D005203ACull },
+        { 0xD38EBA9B8702A3BFull, 0xC09AD09AF107B291ull, 0xC89CE0356EE634C4ull },
+        { 0x6D31141E7406F91Bull, 0x409C74DCA858C514ull, 0xA20DC0FFBA0ED556ull },
+        { 0xAD019201F483F7C5ull, 0x978AEB5D5DC792E6ull, 0x82E7ECD4CBF120A1ull },
+        { 0x85D4D8418152AF54ull, 0xAEE54473C4A25C85ull, 0xD37D6F60089E4A9Eull },
+        { 0x6AD4B3205EB000B0ull, 0x5086FDECF2F641C6ull, 0xAAD71A5AAB16DC6Cull },
+        { 0x21373919FD98B179ull, 0xCDFB065F9731E12Cull, 0x8A00EF4FACFA240Cull },
+        { 0x7CCE6EC4F94F238Full, 0x4A6BCE0443F4A460ull, 0xDEF4F8F7E1972D16ull },
+        { 0xFDD49D71E8358832ull, 0xC0DE4D7B342E171Eull, 0xB41A69468719571Dull },
+        { 0xCDCE6D91E51F41A4ull, 0x7E0CBCFD7B398FBFull, 0x917C765F1837AEC2ull },
+        { 0x91BA91CC0AA09F24ull, 0x21B9EB6C3FF49BE1ull, 0xEB0BAC9B3B6E05A9ull },
+        { 0xA3E1417485DC7060ull, 0x90FC2F469AAD7E8Aull, 0xBDDE4A96FD413A99ull },
+        { 0x36157A4FA13E9150ull, 0x561A2E7426E0AA6Eull, 0x995FD977731CAA85ull },
+        { 0x9D240B253F67404Bull, 0xEB7B90F069177905ull, 0xF7CA2B88155F87A4ull },
+        { 0x74C89E178C289C4Full, 0x05538296DEA43314ull, 0xC829B6E8A0853113ull },
+        { 0xD36102161C63A419ull, 0x74509BB5D9F7572Full, 0xA1B0BA31C60A19AAull },
+        { 0xDB4499F431EACCA0ull, 0x0790B4C3AFD158ABull, 0x829CC762A6F3070Bull },
+        { 0x431D068894B4AC0Eull, 0xC0E644AC7F77AB67ull, 0xD304079AE6C46E24ull },
+        { 0x781D075F431187C6ull, 0x6E7D6F5BDE34E32Bull, 0xAA750850DC9E0233ull },
+        { 0x604B4AA2494252ADull, 0x97616AB9AAA2EBCDull, 0x89B1B6D0A3AC6B50ull },
+        { 0x1E1A8607DBF57AF8ull, 0x07FA7953D9686123ull, 0xDE74FC0F3B4D1BE1ull },
+        { 0x47C9B16AFE8FDF75ull, 0x92E1BC1FBB33F18Dull, 0xB3B305FE328E571Full },
+        { 0x07335534B185A4EDull, 0xF074449FF592BB40ull, 0x9128F245593CABB8ull },
+        { 0x6BDF8EFAD04374DFull, 0x4901443671367503ull, 0xEA84BF30E396DEBEull },
+        { 0x3D2BDF693ED69666ull, 0x1A5A903C572B5870ull, 0xBD714C41B3913439ull },
+        { 0xC1D36752FED667C2ull, 0x8A4798A1AD9278B2ull, 0x9907CE24311B4397ull },
+        { 0x0886D0DD6A488088ull, 0x490C51A999D79171ull, 0xF73BED49A8F83505ull },
+        { 0x44FBACF7CCED420Eull, 0x1423A33DBB66D499ull, 0xC7B6CFB77ED21774ull },
+        { 0xCD714317CC05D69Aull, 0x7FC2F82BB50B4D39ull, 0xA153E8CAA7E304F9ull },
+        { 0xB1BF4AE557E68326ull, 0xD3044E8D195B6CD0ull, 0x8251CD13B875A7A3ull },
+        { 0x093ACF44FA5446B5ull, 0xAA35527055D10B37ull, 0xD28AE5870AB8FB5Aull },
+        { 0x15ED5342AB9165FCull, 0x7A76616D9581EE98ull, 0xAA132E931EDC8229ull },
+        { 0x3E0AAFD8D8EAE21Full, 0x2B9D91C2F0273977ull, 0x8962ABCB939EC527ull },
+        { 0x4E1E056BCD4DC403ull, 0xE615DA33AC7D627Eull, 0xDDF5489F3473EA88ull },
+        { 0xFDBC3168D6B6839Cull, 0x5C180E775768871Bull, 0xB34BDE0F5A0C7247ull },
+        { 0x324BAEFDD11E8E5Full, 0x2B5EFC4366EDCDF9ull, 0x90D59E1CCD369744ull },
+        { 0x1461FA76EBB715DBull, 0x374048F3077E8EC1ull, 0xE9FE1F3AF7E72618ull },
+        { 0x71E3EF6C20696A77ull, 0x9736B4514993E0BAull, 0xBD048C7DAF8ACADBull },
+        { 0x86CCDED5AAD0BA72ull, 0x478DEADB8CA115E5ull, 0x98AFF55B95578037ull },
+        { 0x374AF80AD50A7AD2ull, 0x4ACABF1D83081B53ull, 0xF6AE00B2C08667BBull },
+        { 0xF6B0F4079989A3ADull, 0xEB6DAE51EAB6186Bull, 0xC7442A7C16CD83E9ull },
+        { 0x59843B48DA284866ull, 0xD51C5642EED58649ull, 0xA0F74CABB7E32B9Full },
+        { 0xB037A79474501410ull, 0x5475A8EE52E3A271ull, 0x8206FDCF3D2415AFull },
+        { 0xC170ABBE1F5353FDull, 0xBE7B27AE39AB4E72ull, 0xD21208FC72BDCA9Dull },
+        { 0x6A8BCB1DDE31533Bull, 0x7CFD31C844A148D6ull, 0xA9B18D01209B9768ull },
+        { 0x19BF2974E36622A6ull, 0x926BAC7F1FBA0872ull, 0x8913CE2661C4A648ull },
+        { 0xF1C6255910CC44F0ull, 0x2186750E520A0096ull, 0xDD75DE7D9FFF50A3ull },
+        { 0xC567B816EACD3122ull, 0xD5374E0055281BB6ull, 0xB2E4F157EBCA77D2ull },
+        { 0x0AADE0FCBD74AC4Dull, 0x9A45E217B540BC3Eull, 0x908279C9EEBE645Dull },
+        { 0xBF3561B01F53D6B6ull, 0x69D9C1F7D0B33E49ull, 0xE977CC8D01E8A9B1ull },
+        { 0xD709A820FF4AC848ull, 0x75AAB7CB5CB15414ull, 0xBC980B270680156Aull },
+        { 0x15C2E60DCAA603DFull, 0x69C11DDCCC414E91ull, 0x98584F009C6A413Aull },
+        { 0x345B29EFD4F5A3ACull, 0x1DAD2BC9A915C78Cull, 0xF62065947C6C5138ull },
+        { 0x884239274DE9C02Full, 0xE7B11B906C695FD9ull, 0xC6D1C7108B40F1E0ull },
+        { 0x65DC255BC06E2789ull, 0x42C618DF40F86130ull, 0xA09AE5B65FED1839ull },
+        { 0x49A455F87F1C96B1ull, 0x5791BBC96E52E2D2ull, 0x81BC597C7FE078BAull },
+        { 0x0D6196A191E08276ull, 0xA873639B2294DA38ull, 0xD19971D3340BF431ull },
+        { 0xCD1E8C6144C8F25Dull, 0x36986E7448D74E10ull, 0xA950237AA331B55Dull },
+        { 0xBAC1AB41CA82640Eull, 0xD4D6A6E006527599ull, 0x88C51DC7020DE71Aull },
+        { 0x53C01549BA2BDE86ull, 0xBBFD3961551C1C3Aull, 0xDCF6BD8069190B39ull },
+        { 0x5BB6FE925090B77Full, 0xF55E42DB9F05FFD0ull, 0xB27E3FB5E98DEFC3ull },
+        { 0xE420F394BEBDE5CDull, 0xDD11FAA0C0641C2Cull, 0x902F853148396BC8ull },
+        { 0xC2C4E6EF89CC630Eull, 0x81646CA8EE541B34ull, 0xE8F1C6FAA4AB4B2Aull },
+        { 0x1CF7FA7C26B5FF56ull, 0x49A039502995FEC8ull, 0xBC2BC819E2615A36ull },
+        { 0xD27AF50E40D51519ull, 0xF82A51D9AEC1B8ABull, 0x9800DAF653941692ull },
+        { 0xE6E57C76ABC9290Full, 0x83C40656105F3847ull, 0xF5931BC017F47D4Eull },
+        { 0x54E7C71068C0E5BAull, 0x9454BD0619F5F11Aull, 0xC65FA54F14B23ACBull },
+        { 0xBA211DDCFCE0797Bull, 0xBCC1089E3FE04109ull, 0xA03EB3CC1B723190ull },
+        { 0x61E2895C5FB04864ull, 0xBC285FDBD0E21B25ull, 0x8171E002D9BBE399ull },
+        { 0x70B449709C8D8002ull, 0x0FC4EAFEDD191926ull, 0xD1211FE37AC6A148ull },
+        { 0xFB057BAD1325F8AAull, 0xA903015120C51B50ull, 0xA8EEF1DF7A77E17Full },
+        { 0xE0A0E0663834CBE4ull, 0xAC6D91056350AC66ull, 0x88769A93775E296Cull },
+        { 0xDF2993783AF5AEBAull, 0xA5167C383F290548ull, 0xDC77E57D9312F6D5ull },
+        { 0x392A5C00BCE81102ull, 0xFF83C241640DF1EAull, 0xB217C907689FE0C7ull },
+        { 0x8EC2BF3BE38A04BEull, 0x5BEF0B07F9E0D97Aull, 0x8FDCC03773D05A66ull },
+        { 0x1D8809224E4DFE77ull, 0xF9F421DE03CC0C23ull, 0xE86C0E579CB658EAull },
+        { 0x3723FCAA238490F9ull, 0x9C8D3AD639593A31ull, 0xBBBFC33281B13908ull },
+        { 0x9B6122AA2B72A13Dull, 0x387898A6E22F821Bull, 0x97A9991FD8B3AFC0ull },
+        { 0xC51911DBE9FE42C3ull, 0x70ABC25C37B04B22ull, 0xF5062306E9425FF4ull },
+        { 0x4CE8C373A2054E22ull, 0x3CD77AC32646FF1Dull, 0xC5EDC51201571BECull },
+        { 0x1F5538C36BB518BBull, 0xAC19C04A13D758BAull, 0x9FE2B6CE7768A65Cull },
+        { 0x95718B8B3E711833ull, 0x498A7CD3001DDF1Aull, 0x81279149B1EE3018ull },
+        { 0xFF5FAE17CB052271ull, 0xA3BC4B8D864B090Aull, 0xD0A9130589EDE499ull },
+        { 0xDB79BB37FB5DBE2Aull, 0xA4199EEF1EBC2A4Dull, 0xA88DF80F8CBF1328ull },
+        { 0x71F222756CD12875ull, 0x67E12FFAF8EE395Bull, 0x88284471D3844320ull },
+        { 0xFDFF886A3A5DA32Eull, 0x53CB2BAB20C8A14Dull, 0xDBF9564B39593183ull },
+        { 0x30216BADC5142BDCull, 0x6E6BF9CE2AD0B7F5ull, 0xB1B18D2A91C19C90ull },
+        { 0x5B640207D635E507ull, 0x9C1435EEB943C6A5ull, 0x8F8A2AC11B6624BAull },
+        { 0xF83913DA2B74B647ull, 0x116B4A5727F0159Aull, 0xE7E6A277BFF9EFABull },
+        { 0x9FE56430855FAC72ull, 0x105742BED0C6A265ull, 0xBB53FC4D3778DC01ull },
+        { 0x57BF9C6616557D16ull, 0xC5A219BCDEDE449Aull, 0x975289605A3C51BCull },
+        { 0x6EE414AF89911334ull, 0x92BD31F0553395BAull, 0xF4797B3A6142EBE2ull },
+        { 0x2F9AA173B0A7210Aull, 0x1F7261D06D0550C6ull, 0xC57C2633B508C348ull },
+        { 0xD1004194C0B70852ull, 0x704AAE82A57B7992ull, 0x9F86EE9F12415EC4ull },
+        { 0xE18608B18B5BB332ull, 0x01DC46E7609057D4ull, 0x80DD6D387DCDDF51ull },
+        { 0x06B6810C693A3893ull, 0x32C001B8DBF097CEull, 0xD0314B11BB519A8Cull },
+        { 0x38906C3B8EF6233Full, 0xD417D8D845391C56ull, 0xA82D35EAD2C59980ull },
+        { 0xFC896F8CCB046189ull, 0x2F52610FEBFA41FAull, 0x87DA1B483731ADC4ull },
+        { 0xC4F4174D2DCABBF2ull, 0x3BDB125A42B0F59Full, 0xDB7B0FBF8F6444CDull },
+        { 0x10E5B540656D63CCull, 0x0C092819405164DCull, 0xB14B8BFDA121929Aull },
+        { 0xABB9B7C321E2D5D5ull, 0x5872038CB07F2F72ull, 0x8F37C4B2F88EFFA7ull },
+        { 0x2DB077BE9D18B001ull, 0x07CD71A4AD11C394ull, 0xE761832EFDC06462ull },
+        { 0x94F7C277CDE40E6Full, 0xEEE81FE452CA1BE4ull, 0xBAE873466B3C2F39ull },
+        { 0xE669046AA808CE8Full, 0x8429CCC80533E246ull, 0x96FBAB9B172C5266ull },
+        { 0xC8B9043A577BCC6Bull, 0xB1F0B9E55C69ADF5ull, 0xF3ED242C0B9D320Cull },
+        { 0x19DFAD135D617905ull, 0x249494D1BF7C86ECull, 0xC50AC88EA93763C0ull },
+        { 0x387D93F74A8B7EB8ull, 0xC044D6838C73EE53ull, 0x9F2B5B1F9BDDF3ABull },
+        { 0xE5B7008ECD56A9CAull, 0x4682720E2DEFBD71ull, 0x809373B6C0C7FEB3ull },
+        { 0x5C9BA15688864CF4ull, 0x78D4EEC12147FC44ull, 0xCFB9C7E07F8450E1ull },
+        { 0x1AB477870F365102ull, 0xD0C3EBC7BDCD296Full, 0xA7CCAB5157AC8785ull },
+        { 0x681129A46FD9AA8Dull, 0xD43A93646568783Full, 0x878C1EFCD1F1FB14ull },
+        { 0x9E6F3088B034BD57ull, 0x8D5C0DD565C6F501ull, 0xDAFD11B0E0AB57A7ull },
+        { 0xC54A53AC9BDF4C3Dull, 0x834CE1D13D803337ull, 0xB0E5C55EE650295Eull },
+        { 0x628B82D2D36CD405ull, 0x62EC8CDD84CED00Dull, 0x8EE58DF1D4875E53ull },
+        { 0x0B8262369A924420ull, 0xE85151EB065007BBull, 0xE6DCB0515E9FB693ull },
+        { 0xF4B61A55C457276Dull, 0x423CDCAB7D64BF60ull, 0xBA7D27FA98EE1F30ull },
+        { 0xC3B8A4428BDAF0BFull, 0x4F0D0669905E18CEull, 0x96A4FFB35F03995Dull },
+        { 0x6588DA684EB6ED1Aull, 0xD054CD6262834DA1ull, 0xF3611DAD8EA309EDull },
+        { 0x667E610A96265480ull, 0x00FDE9A3EABF130Cull, 0xC499ABFD6CDDD04Bull },
+        { 0x1E81CC604252E9FBull, 0x9AC0936257D9C76Cull, 0x9ECFFC31D586ABC0ull },
+        { 0xAC261E9F5141430Cull, 0x205B896D777D6278ull, 0x8049A4AC0C5811AEull },
+        { 0x475F2B7D7DF1AD7Bull, 0x52064CAC828675B9ull, 0xCF42894A5DCE35EAull },
+        { 0x657C8F4D43323A37ull, 0xAF2AF2B80AF6F24Eull, 0xA76C582338ED2621ull },
+        { 0xCC35EDDFCF0996D8ull, 0x5A7744A6E804A291ull, 0x873E4F75E2224E68ull },
+        { 0xA30294CC2934E663ull, 0xAF39A475506A899Eull, 0xDA7F5BF590966848ull },
+        { 0xFE13A5C86AF64419ull, 0xBD8D794D96AACFB3ull, 0xB080392CC4349DECull },
+        { 0x41B0230E1421487Eull, 0x547EB47B7282EE9Cull, 0x8E938662882AF53Eull },
+        { 0xA3B561B1CB208397ull, 0x0CB4A5A3112A5112ull, 0xE65829B3046B0AFAull },
+        { 0x21A0183E10583CD4ull, 0x92F34D62616CE413ull, 0xBA121A4650E4DDEBull },
+        { 0xE9082F25E9C5E9EDull, 0x3A6A07F8D510F86Full, 0x964E858C91BA2655ull },
+        { 0x3695DAD7E8858902ull, 0xFAE27299423FB9C3ull, 0xF2D56790AB41C2A2ull },
+        { 0x96842DC95323F5A9ull, 0xAA97E14C3C26B886ull, 0xC428D05AA4751E4Cull },
+        { 0xCA49F1C05120C9C8ull, 0x775EA264CF55347Dull, 0x9E74D1B791E07E48ull },
+        { 0x0000000000000001ull, 0x0000000000000000ull, 0x8000000000000000ull },
+        { 0x0000000000000001ull, 0x0000000000000000ull, 0xCECB8F27F4200F3Aull },
+        { 0x0000000000000001ull, 0x999090B65F67D924ull, 0xA70C3C40A64E6C51ull },
+        { 0xDF9F915627C04E29ull, 0x69A028BB3DED71A3ull, 0x86F0AC99B4E8DAFDull },
+        { 0xD74BAAD03BC1D8D4ull, 0xE80E6F4820CC9495ull, 0xDA01EE641A708DE9ull },
+        { 0xC04C79FFE3243020ull, 0x5EC05DCFF72E7F8Full, 0xB01AE745B101E9E4ull },
+        { 0x23BD6A2059C002F6ull, 0x14588F13BE847307ull, 0x8E41ADE9FBEBC27Dull },
+        { 0xF0B5CCF5176ECC7Dull, 0x8F1668C8A86DA5FAull, 0xE5D3EF282A242E81ull },
+        { 0x88EFB0037AC08BDFull, 0x6D953E2BD7173692ull, 0xB9A74A0637CE2EE1ull },
+        { 0x0D5A4AF7B3A98E48ull, 0x4ABDAF101564F98Eull, 0x95F83D0A1FB69CD9ull },
+        { 0x3D9C44CD2F36917Dull, 0xBC633B39673C8CECull, 0xF24A01A73CF2DCCFull },
+        { 0x02606EA01029DC38ull, 0x0A862F80EC4700C8ull, 0xC3B8358109E84F07ull },
+        { 0x4944D9F52CD0DEC3ull, 0x6C07A2C26A8346D1ull, 0x9E19DB92B4E31BA9ull },
+        { 0x631FCDFBCB35B8A5ull, 0x9798278AEA58EFFFull, 0xFF6D0B3492801150ull },
+        { 0xCE6793518AB47106ull, 0x34A44C6FE697A290ull, 0xCE54D951F70637D5ull },
+        { 0x074CE5CC340E0433ull, 0xF33565B6F98557B1ull, 0xA6AC5789E1DA7D57ull },
+        { 0xD44DF643A55413DBull, 0xD76D70B23D7AB65Aull, 0x86A3364EA62C672Cull },
+        { 0x976473182E9F1593ull, 0xAB5D542942F2F0D5ull, 0xD984C8D3115A426Bull },
+        { 0xE4C7498EFC6EC4C1ull, 0xB5E6504852F42E70ull, 0xAFB5CF88362BAFD0ull },
+        { 0x61BF723F122C0FF5ull, 0x3FBF59B4F5B2379Bull, 0x8DF0046D27C91B1Cull },
+        { 0xE8FAAB60ABAFCA95ull, 0xE15CF9BEEBD044DEull, 0xE550008523ED219Aull },
+        { 0xF1C23786E6DF69E0ull, 0xD119951DCBACC155ull, 0xB93CB71706A3B990ull },
+        { 0xE864196140FED6B6ull, 0x81624514B014EE42ull, 0x95A2260F89C4D57Bull },
+        { 0x6E20A508C0D24EE9ull, 0x2703188C5B07FB0Bull, 0xF1BEEBC339ACCD47ull },
+        { 0x7593FF5A4A2C97BBull, 0xD94035B4BFFD40C3ull, 0xC347DB4B6C88001Full },
+        { 0x53A483E07423EBB3ull, 0xFBDD0BE7ED786DE0ull, 0x9DBF19A533CEFBABull },
+        { 0x4C0B056C774F8867ull, 0x25FC7FEE530BB131ull, 0xFEDA6AC5471D72F0ull },
+        { 0xE7B02C4CF566112Cull, 0x95DEAB11265E66AEull, 0xCDDE67A1319BA5D8ull },
+        { 0x7A0E5D37872CDA01ull, 0x8F96BEE42FDA4243ull, 0xA64CA9DF3FD42CF6ull },
+        { 0xC475C2CD722A6A0Bull, 0x7D90849C966E61F2ull, 0x8655EC7B208BD47Aull },
+        { 0xAD2E9E9D5DC29FE0ull, 0x03CB93D1C8DD139Aull, 0xD907EB19203BB3D9ull },
+        { 0x5218D5862B929D87ull, 0x79211E057260D9F8ull, 0xAF50F1D2F05B2DDFull },
+        { 0x8471BAFF2D83DF7Eull, 0x7E289E1EABE77166ull, 0x8D9E89D11346BDA5ull },
+        { 0xB33D929771C5C84Aull, 0xC3ECBC73DA77D84Bull, 0xE4CC5D9E5EF9ABD5ull },
+        { 0xE5B9EFA08408D4B4ull, 0xAB4BC6D01F18AFE3ull, 0xB8D261558A9F62D1ull },
+        { 0xDB0E8A03BC0E1D19ull, 0x20C44A4F7D0860B1ull, 0x954C4080610C746Full },
+        { 0xFF0F2F2EBA5C516Eull, 0x6C0DC5F96FA55FBAull, 0xF13425B6B1D3C874ull },
+        { 0x8C818EF0893D5B21ull, 0x93DBABAA9496F8A8ull, 0xC2D7C194B0FE2337ull },
+        { 0x30640F25EB849925ull, 0x46F257C7FCB4D721ull, 0x9D648BD115237172ull },
+        { 0x57C584C654481A08ull, 0x7D777A075CF07C4Bull, 0xFE481E81B0A1D67Eull },
+        { 0x6129789E1430ABDEull, 0x716CCEB16A9F7C01ull, 0xCD6839EE857CF792ull },
+        { 0xC868A4002278B368ull, 0x86C7E9B8D0C00844ull, 0xA5ED332126AC89ADull },
+        { 0x97BCB55C47003613ull, 0x8EFD75E3BADAA6A8ull, 0x8608CF059D55AC82ull },
+        { 0xEC2D197C86BA39DEull, 0x959638798910F120ull, 0xD88B550D09B71DC5ull },
+        { 0xA29AE4B9277432B2ull, 0xA7042F03419B03AEull, 0xAEEC4E048F6436EFull },
+        { 0x18A37BC7831415A3ull, 0xCEBC6D4653571871ull, 0x8D4D3DFAD563E9C4ull },
+        { 0x9B7E98773708F0DCull, 0xD83180E3FD1C10D0ull, 0xE44906486180F7C4ull },
+        { 0xBAB935BB27E5C954ull, 0x8A00BF1C7D672834ull, 0xB868489EA52FACD4ull },
+        { 0x64B1A574DA085745ull, 0x0C8BEC274F660D07ull, 0x94F68C404707858Aull },
+        { 0xD1AFD23AE4C0BFD4ull, 0xFC3B2DEF8A1294AAull, 0xF0A9AF53D02A967Dull },
+        { 0x6CB43C20051FE74Cull, 0x7C062DED3659A77Cull, 0xC267E837D141BC8Dull },
+        { 0x96E5CCBFC6D8648Full, 0x53E7C5875445253Bull, 0x9D0A31F87094C521ull },
+        { 0x68A94E294129E209ull, 0x36A4DE1AD2545260ull, 0xFDB626397DA38527ull },
+        { 0x69B82FC17957176Cull, 0x59CCC6B23088E41Dull, 0xCCF25012EABB880Bull },
+        { 0x6F3E39C41C9DD290ull, 0x3282634F0202562Eull, 0xA58DF3300EF86CFBull },
+        { 0x1DFBF57DF1B27F52ull, 0xA23E757AD8D0BC2Full, 0x85BBDDD4A47FB2C0ull },
+        { 0xEAE6C2843752AC36ull, 0xB7157C60A24A0569ull, 0xD80F0685A81B2A81ull },
+        { 0xFC3AA0AD0F639F2Eull, 0xE8C99E31E854C6C6ull, 0xAE87E3FBD63A31F4ull },
+        { 0x64553AF7F46E9E62ull, 0xDE1BE7044F365CABull, 0x8CFC20CF94927D0Aull },
+        { 0x8D2C9DDC82124A18ull, 0x0E38F9F2A00CF777ull, 0xE3C5FA57CAAF3724ull },
+        { 0x1E0A8A50F37053C6ull, 0xAA35DDF8E079A523ull, 0xB7FE6CCF4BEC1DCEull },
+        { 0x0811F3EE6235FDAAull, 0x2BC2A33C0B7D34BFull, 0x94A10932ED791DAAull },
+        { 0x6143BAAC3E29D135ull, 0x2DD02DDBE5B3E4A6ull, 0xF01F886CD9C3701Eull },
+        { 0x939AD94C05DADC41ull, 0x967F91E225D40AB4ull, 0xC1F84F0FDC8AA8ACull },
+        { 0x5C0648C4E9E45FABull, 0x2E61AA868501E740ull, 0x9CB00BFD6F025339ull },
+        { 0x808455565D65F3AEull, 0x2B294BA48F2E6D98ull, 0xFD2481BC78756A5Eull },
+        { 0xDE77358FE0F74E39ull, 0x67F3AAE343FEB72Dull, 0xCC7CA9E76FD08AF9ull },
+        { 0x9BF32BCAAD698B03ull, 0xE185CB4EF92734EBull, 0xA52EE9EC83661199ull },
+        { 0x086D36E755D762F4ull, 0xA804B2EE7A67EC76ull, 0x856F18CECC9E7B2Dull },
+        { 0x62A4C615B80539A9ull, 0x1FB74D27227C736Cull, 0xD792FF59ED555C20ull },
+        { 0x6291A42075945160ull, 0xD32CC6CDCCC98860ull, 0xAE23B3979AE51FABull },
+        { 0xF255C21AC1DE66F8ull, 0x74F99BDEAE601FADull, 0x8CAB323486AE14C9ull },
+        { 0x69FFE1E2542139D7ull, 0x2F570B82BAA59A9Cull, 0xE34339A152974F3Dull },
+        { 0x458E5354B97D9E4Bull, 0x906AE1E0F53D7665ull, 0xB794CDC48889AD4Eull },
+        { 0xB316E20FD77E4CBFull, 0xB4C43D1362FFCA2Eull, 0x944BB73C1664017Bull },
+        { 0xDDBCEC288C1F1430ull, 0x68B976D66D196048ull, 0xEF95B0D42DF0E42Cull },
+        { 0x9AA189B8E5729D8Bull, 0x9E39B04FB4C5F8DBull, 0xC188F5F7F745691Dull },
+        { 0x69671756C20EFB45ull, 0x9737C50CBC575999ull, 0x9C5619C24A6CB198ull },
+        { 0x9038240858BF5B82ull, 0x135E677B1EEA0374ull, 0xFC9330DA871727C5ull },
+        { 0x2B5EBE14DDF6A871ull, 0xDFE34C32965D5196ull, 0xCC07474539903019ull },
+        { 0x5A5EE8E2E9CD1CE1ull, 0xD0DB0C7C5E6A3C5Eull, 0xA4D0173720B2AFB7ull },
+        { 0xC6571C0B2427A490ull, 0x06C337A332C332ABull, 0x85227FDABADD05B2ull },
+        { 0x4C41367E2524DBD0ull, 0xB06F2210665F31E1ull, 0xD7173F60E2E47D48ull },
+        { 0xFE2D99A281A011ADull, 0x65C13361E6B2C078ull, 0xADBFBCB6C676A69Bull },
+        { 0x1720BEB1E919B4C2ull, 0x11C0B3BACD7601B3ull, 0x8C5A720EF0F33507ull },
+        { 0x01D79EB320D9DFDBull, 0xCA859FBEC873DA69ull, 0xE2C0C3F9CA248D85ull },
+        { 0x76F0BF554CE6FCA7ull, 0x57BA8EE8D680A9CBull, 0xB72B6B5B78CF3835ull },
+        { 0x82B1078B3FF95EF3ull, 0x4C915657A40419B4ull, 0x93F6963F9401519Dull },
+        { 0x351DE2DCFD4B97F1ull, 0xDBA4FAFB27248AFCull, 0xEF0C285C4636C5D1ull },
+        { 0xB7B9869446EA1495ull, 0xE493D2DC9A90CA32ull, 0xC119DCCB5B06F819ull },
+        { 0xA4CE229EC62F801Aull, 0x05176D45D7D49F2Eull, 0x9BFC5B294DEBDA29ull },
+        { 0x5422B2805D106D42ull, 0x04BB4BE11BBB6522ull, 0xFC023363AB253235ull },
+        { 0xCF6AADD2A9896CAAull, 0xF8A70F696B3EADC9ull, 0xCB922805831CCDECull },
+        { 0x14B556B7961FFB18ull, 0xFC8794AD3F299058ull, 0xA4717AF095A01F25ull },
+        { 0x0BC1E149AF11D4BAull, 0x15B894F9E47407D8ull, 0x84D612DF22F45E69ull },
+        { 0x72BB82FAF94AB3DFull, 0xDB2CF10BAA20004Cull, 0xD69BC671A9CB19D3ull },
+        { 0x15E6ADB85C868CCAull, 0x2AB1AA038B8D63A1ull, 0xAD5BFF3854FF2560ull },
+        { 0x9438151930B5B3F2ull, 0xC1362A72F3DA1752ull, 0x8C09E04427F67486ull },
+        { 0x791C174B1DBE74E4ull, 0xC9E90C70B4033B07ull, 0xE23E99361B0C6471ull },
+        { 0x6D09CF8E885913A5ull, 0xE767940F5C09FB62ull, 0xB6C245714E89FB50ull },
+        { 0xC885196C0B65BD10ull, 0xE4DF06EB48627AE8ull, 0x93A1A62148B73C1Eull },
+        { 0xB7E242F4CE1D15FEull, 0xBFFB63F6DF677A4Full, 0xEE82EED7B63B2364ull },
+        { 0xFEDFB6B16FB0D120ull, 0x1978180CCCB813A7ull, 0xC0AB03655680A33Bull },
+        { 0xCBAC3303307E2E00ull, 0xB631D78033FC5DE7ull, 0x9BA2D014D5A55B2Full },
+        { 0x6A3075A4F01DF87Cull, 0x91C5999739C6F4BCull, 0xFB71892801C8F7E6ull },
+        { 0x8F9D3DE52E498712ull, 0x8AB05967FF2004E2ull, 0xCB1D4C019DDA13CFull },
+        { 0xFD2F786671408629ull, 0x5B35BBA10C44DA14ull, 0xA41314F9A2EA7F7Aull },
+        { 0xEAAE04D3132BD346ull, 0x336395197E665816ull, 0x8489D1C2C72342B3ull },
+        { 0x438BEEC83DCD35D6ull, 0x317F29750B52FB66ull, 0xD62094637A81FF2Aull },
+        { 0x202E589641E92248ull, 0x5AE6AE711D4F1F20ull, 0xACF87AFB5582CB3Dull },
+        { 0xEC5EB9CEBC2B6C8Eull, 0x4BACE26EF9B78AB7ull, 0x8BB97CB98F9BADE1ull },
+        { 0xD7A2F93D2F21F5B3ull, 0xFB97DB142B0810F1ull, 0xE1BCB92B47C03075ull },
+        { 0x9CC3B1569B1325A5ull, 0x40C3A071220F5567ull, 0xB6595BE34F821493ull },
+        { 0xDFAD852D8E2E4E71ull, 0x460438DEF65AD3ACull, 0x934CE6C5270FB358ull },
+        { 0xEA3C4033444A5A32ull, 0x3576770DB8927589ull, 0xEDFA04192BB745E5ull },
+        { 0x20449C8D0B35D130ull, 0xF86FF4509C2DE041ull, 0xC03C69A14D73ED23ull },
+        { 0xDE7AAA380E31E231ull, 0x956CDE3A40929AEAull, 0x9B4978674EC28D40ull },
+        { 0x354EFA85E2B073B8ull, 0x4F5A98DC41719954ull, 0xFAE131F7C3A90FB3ull },
+        { 0x190436E78A9C4FEBull, 0x69F9D02F3FC6F5DEull, 0xCAA8B312F160436Eull },
+        { 0x3E6349FC8C8B429Aull, 0x1A4E9C5FC9B4E151ull, 0xA3B4E5331B3DE622ull },
+        { 0x393DBB61C19D17FFull, 0xB4F58D5111702E25ull, 0x843DBC6C7825CB13ull },
+        { 0x5E39838C7371720Dull, 0xA5143CD342217944ull, 0xD5A5A90DA4EAC463ull },
+        { 0x7E75FE04148E6733ull, 0x6CA63EAB5349E800ull, 0xAC952FDEE9EEB6F0ull },
+        { 0xD324EFBE8E93BA73ull, 0xCE11C5FCFB9F5544ull, 0x8B6947549B0D35ACull },
+        { 0xDEED2BC5B2A7B3E0ull, 0xDA7901D26B12686Bull, 0xE13B23AE6B5F0535ull },
+        { 0x91EF7506715C9D82ull, 0x1985C8508443835Aull, 0xB5F0AE8ED56F0AE3ull },
+        { 0x4E15FEFEA3966309ull, 0x33A8D740EE102CFAull, 0x92F8580F31AF2A14ull },
+        { 0x8D9613DEBCB8CE62ull, 0xC0EB0EC64FDBE987ull, 0xED7167F36E68B916ull },
+        { 0x9C65E36AC2D966ADull, 0xDA1276A2F5DEBC0Bull, 0xBFCE0F5AB8A6761Dull },
+        { 0xF8E198535001AD68ull, 0xB768FC3A8C5EAB07ull, 0x9AF054033766CECFull },
+        { 0xAE7380142D29C40Dull, 0x86212E823AE944B8ull, 0xFA512DA344D9716Bull },
+        { 0xA76BC5D985B77CC2ull, 0x33C62A59A4E6A4B7ull, 0xCA345D12FB6F718Full },
+        { 0x6F4174F724760F30ull, 0x71F7A8277AC659D2ull, 0xA356EB7DE32C1260ull },
+        { 0x0AB3EFC65F2BC2B8ull, 0xEDEA76E81580BEEBull, 0x83F1D2C3152D19D7ull },
+        { 0xDBB130A26A57C55Aull, 0x075F663779EE412Eull, 0xD52B044790425A22ull },
+        { 0xF866A21F1992F28Bull, 0x74CFCA1261553B6Eull, 0xAC321DC2470E1BC3ull },
+        { 0x480CDDABFFDB6FC5ull, 0xD7C0B2CE95053648ull, 0x8B193FFACCB315AFull },
+        { 0x7CCEAF8630423B1Cull, 0xE6BE49BB6CDBB30Aull, 0xE0B9D894B9A782D7ull },
+        { 0x00D81D678B4F094Eull, 0xF8D3473ABEED8B25ull, 0xB5883D514DEC5C81ull },
+        { 0x8A4C4BF452F52B3Aull, 0x1CDDB259A0934442ull, 0x92A3F9E37B4B550Dull },
+        { 0x4B177262F816F9BBull, 0x7CB5735C85C60AD7ull, 0xECE91A3960025C31ull },
+        { 0x564F5D455991BAF7ull, 0x2B7B24B4DE1504BDull, 0xBF5FF46D25D5EBA7ull },
+        { 0xBBC57F2DD93AD761ull, 0x358A3F3BF501A1E3ull, 0x9A9762CB1EA5C55Eull },
+        { 0x4ACF6DF32328A59Bull, 0xD9F504D7C804D52Eull, 0xF9C17BFAF4CBB73Aull },
+        { 0x7A22EC3378C938C5ull, 0x5A3B5835F1148253ull, 0xC9C049DB4FE2CE2Aull },
+        { 0x0F8943D48266681Full, 0xAA5B1D1DC6D84665ull, 0xA2F927BAF1222736ull },
+        { 0x33814907ADCF7DD2ull, 0x9083904B89010143ull, 0x83A614AD8BD70E84ull },
+        { 0xFBC19D86EC783019ull, 0x5832112E515848A7ull, 0xD4B0A5E8BB13A222ull },
+        { 0xB47F420EC8F9E7CFull, 0xC4E76EB3D5B6868Cull, 0xABCF4484B47F6CDAull },
+        { 0xD8E0EDA6E7985E8Bull, 0x27BD783D3FF05753ull, 0x8AC96691B62A4D1Dull },
+        { 0x73F206D5AEFBC60Eull, 0xE031C0396758BC3Eull, 0xE038D7B37EE9B37Bull },
+        { 0x49B4AB45E5643E08ull, 0x0F6A599F844511F3ull, 0xB52008083A6E1404ull },
+        { 0xB4227AF459926F75ull, 0x4A05A4CE3E8149F0ull, 0x924FCC2626A1F1B8ull },
+        { 0xB0398B32745AA54Full, 0x0C0D5A1C5E683876ull, 0xEC611ABDFC1D7B26ull },
+        { 0xB22C28F6A5E137AAull, 0xCFC31E8114F8AA04ull, 0xBEF218B437ABFEEEull },
+        { 0x0B1172D3D161F0AFull, 0x2F0C0B47E0C72C1Eull, 0x9A3EA4A1A479A43Full },
+        { 0xE2AA0ACB5C88DB4Cull, 0xB4192B17A5DD508Dull, 0xF9321CCF5E3F6816ull },
+        { 0x25E3EB45914AB6A1ull, 0x3A857F556A15CD7Cull, 0xC94C794598A3F3D2ull },
+        { 0x9788FF46F4D5D60Bull, 0xED964EA33B0CE405ull, 0xA29B99CB4D5E6B31ull },
+        { 0x8E0E4FF01A293FF6ull, 0xA974FD5AE9248788ull, 0x835A8212D825FE06ull },
+        { 0xB1978DAA93ECAF38ull, 0x75A77A3B0BC28F4Dull, 0xD4368DC8BB2A0E80ull },
+        { 0xA6E6122F56F94A46ull, 0x323264FA08A6A297ull, 0xAB6CA4058CA98EBAull },
+        { 0x9F99655C0C0BA779ull, 0x2595C95A2E358D90ull, 0x8A79BAFEF83C15D5ull },
+        { 0x00CA224B2E96FB50ull, 0x373CA7CC8CB15E20ull, 0xDFB820E01FF8F0CEull },
+        { 0xE7DA23AB42829DAEull, 0x058A55AE6F52789Cull, 0xB4B80E91303563D6ull },
+        { 0x42328F67F2D45C19ull, 0x7CB930E3F1D0D4FBull, 0x91FBCEBB666F925Cull },
+        { 0x162D5B51A1DD9595ull, 0x655BB1B7AA4E8196ull, 0xEBD96954582AF06Full },
+        { 0xEFACCD9E402E53F1ull, 0x71BFC41D1945F4AAull, 0xBE847C0BA5B26238ull },
+        { 0xBF66D66CC34F0198ull, 0xBA00864671D1053Full, 0x99E6196979B978F1ull },
+        { 0x4F3BDEF535D378F9ull, 0x3FFC995B804723FBull, 0xF8A30FF127324B31ull },
+        { 0xB7E4D0DDE394A308ull, 0x0C968BD740DF1E9Cull, 0xC8D8EB2B959E3E63ull },
+        { 0x376137BFF9D207F1ull, 0x839B51E97CD386DFull, 0xA23E419011E60E1Bull },
+        { 0x7147D518B7B90ED7ull, 0x7AA9AAAD2BD665FEull, 0x830F1ADA04786FA5ull },
+        { 0x5ED9E296057D06E6ull, 0xC24AE577CC6A1D08ull, 0xD3BCBBBF3D8448A8ull },
+        { 0x7291576BB155E045ull, 0x743430006A9561A2ull, 0xAB0A3C243CB10EFEull },
+        { 0x9A9405698F23B009ull, 0x33D9A7DFC76AD75Aull, 0x8A2A3D2842D52EAAull },
+        { 0x05FE05C25DE30879ull, 0x0C3C6778B928529Full, 0xDF37B3F01A1DD1B4ull },
+        { 0x8588ABA0FD287D87ull, 0xFB5E59F448EFA1F5ull, 0xB45050C9D845484Cull },
+        { 0x85D1E56B26CF702Cull, 0xF78D77515F2A1101ull, 0x91A801877D666F70ull },
+        { 0x1B6E7F06C32E75B1ull, 0x8A7F9F7FB0392E35ull, 0xEB5205CFA3644F6Dull },
+        { 0xA8E484B1BDA89D21ull, 0xCE925375D8ACBE52ull, 0xBE171E4F3C46CD25ull },
+        { 0x115F864F6A1774D4ull, 0x8FF47334B36458A0ull, 0x998DC105600F7D0Cull },
+        { 0x10CFA0C328D5006Bull, 0xCD557BAF08B41588ull, 0xF814553110D0C46Bull },
+        { 0x4DACB352F72321C5ull, 0x7DFF02D84CE763AEull, 0xC8659F671CB228F7ull },
+    };
+
+
+    /**
+     *  5^i for all i < pow10_significands_step.
+     */
+    inline constexpr auto pow5_table = [] {
+        std::array<uint64_t, pow10_significands_step> table{};
+        uint64_t p = 1;
+        for (uint64_t& v : table) {
+            v = p;
+            p *= 5;
+        }
+        return table;
+    }();
+
+
+    /**
+     *  Returns a 192-bit approximation of the significand of 10^e, such as 'pow10_significands' but for any exponent
+     *  in its range. The result overestimates the exact value by less than 3 units.
+     */
+    constexpr std::array<uint64_t, 3> compute_pow10_significand(int32_t e)
+    {
+        const int32_t index = (e - pow10_significands_min_exponent) / pow10_significands_step;
+        const int32_t offset = (e - pow10_significands_min_exponent) % pow10_significands_step;
+        const uint64_t (&base)[3] = pow10_significands[index];
+        if (offset == 0) {
+            return { base[0], base[1], base[2] };
+        }
+
+        // 10^e = 10^(e - offset) * 5^offset * 2^offset
+        const auto p = mul_limbs(std::array<uint64_t, 3>{ base[0], base[1], base[2] },
+                                 std::array<uint64_t, 1>{ pow5_table[offset] });
+        const int32_t shift = floor_log2_pow10(e) - floor_log2_pow10(e - offset) - offset; // between 0 and 63
+
+        std::array<uint64_t, 3> g{};
+        for (size_t i = 0; i < 3; i++) {
+            g[i] = shift == 0 ? p[i] : (p[i] >> shift) | (p[i + 1] << (64 - shift));
+        }
+
+        // Round up, so that the result is always above the exact value
+        for (uint64_t& limb : g) {
+            if (++limb != 0) {
+                break;
+            }
+        }
+        return g;
+    }
+
+
+    /**
+     *  Floating point types properties needed for their conversion to decimal. Only IEEE 754 binary32 and binary64,
+     *  and the x87 80-bit extended precision format are supported.
+     */
+    template<typename T>
+    struct FloatTraits
+    {
+        static constexpr int32_t digits = std::numeric_limits<T>::digits;
+
+        static_assert(digits == 24 || digits == 53 || digits == 64, "Unsupported floating point format");
+
+        // Binary exponent of the smallest subnormal value (and of all subnormal values)
+        static constexpr int32_t min_exponent = std::numeric_limits<T>::min_exponent - digits;
+
+        // Large enough for the significand multiplied by 64 (needed by 'shortest_decimal')
+#ifdef __SIZEOF_INT128__
+        typedef std::conditional_t<digits <= 53, uint64_t, unsigned __int128> carrier;
+#else
+        static_assert(digits <= 53, "64-bit significands need 128-bit integers");
+        typedef uint64_t carrier;
+#endif
+    };
+
+
+    /**
+     *  The value of a floating point number is 'significand * 2^exponent'.
+     */
+    template<typename T>
+    struct DecomposedFloat
+    {
+        typename FloatTraits<T>::carrier significand;
+        int32_t exponent;
+        bool negative;
+        bool is_nan;
+        bool is_inf;
+        // If the significand is a power of 2, the previous floating point value is twice closer than the next one
+        bool lower_boundary_closer;
+    };
+
+
+    /**
+     *  Decomposes a positive x87 80-bit long double with only arithmetic operations, for compilers which cannot
+     *  'std::bit_cast' it in constant expressions.
+     */
+    template<typename T>
+    constexpr DecomposedFloat<T> decompose_float_arithmetic(T val)
+    {
+        typedef FloatTraits<T> traits;
+
+        // 2^(2^i)
+        constexpr auto pow2_pow2 = [] {
+            std::array<T, 14> table{ 2 };
+            for (size_t i = 1; i < table.size(); i++) {
+                table[i] = table[i - 1] * table[i - 1];
+            }
+            return table;
+        }();
+
+        DecomposedFloat<T> res{};
+        res.negative = val < 0 || (val == 0 && __builtin_copysignl(1, val) < 0);
+        if (val != val) {
+            res.is_nan = true;
+            return res;
+        }
+        if (res.negative) {
+            val = -val;
+        }
+        if (val > std::numeric_limits<T>::max()) {
+            res.is_inf = true;
+            return res;
+        }
+        if (val == 0) {
+            return res;
+        }
+
+        // Find 'e' such as 2^e <= val < 2^(e+1), and scale 'val' to [1, 2). All operations are exact.
+        int32_t e = 0;
+        if (val >= 1) {
+            for (int32_t i = pow2_pow2.size() - 1; i >= 0; i--) {
+                if (val >= pow2_pow2[i]) {
+                    val /= pow2_pow2[i];
+                    e += 1 << i;
+                }
+            }
+        }
+        else {
+            while (val * pow2_pow2.back() < 2) {
+                val *= pow2_pow2.back();
+                e -= 1 << (pow2_pow2.size() - 1);
+            }
+            for (int32_t i = pow2_pow2.size() - 2; i >= 0; i--) {
+                if (val * pow2_pow2[i] < 2) {
+                    val *= pow2_pow2[i];
+                    e += -(1 << i);
+                }
+            }
+        }
+
+        const bool normal = e >= traits::min_exponent + traits::digits - 1;
+        const int32_t shift = normal ? traits::digits - 1 : e - traits::min_exponent;
+        for (int32_t i = 0; i < 6; i++) {
+            if ((shift >> i) & 1) {
+                val *= pow2_pow2[i];
+            }
+        }
+
+        res.significand = static_cast<uint64_t>(val);
+        res.exponent = normal ? e - (traits::digits - 1) : traits::min_exponent;
+        res.lower_boundary_closer = normal && e > traits::min_exponent + traits::digits - 1
+                                    && res.significand == uint64_t(1) << (traits::digits - 1);
+        return res;
+    }
+
+
+    /**
+     *  Extracts the sign, exponent and significand of a floating point number.
+     */
+    template<typename T>
+    constexpr DecomposedFloat<T> decompose_float(const T& val)
+    {
+        typedef FloatTraits<T> traits;
+        typedef typename traits::carrier carrier;
+
+        uint64_t fraction;       // Significand bits, excluding the integer bit
+        uint32_t biased_exponent;
+        uint32_t max_biased_exponent;
+
+        DecomposedFloat<T> res{};
+
+        if constexpr (traits::digits == 64) {
+            if (std::is_constant_evaluated()) {
+                return decompose_float_arithmetic(val);
+            }
+
+            // x87 format: 64 bits of significand, with an explicit integer bit, followed by the exponent and sign bit
+            const auto bytes = std::bit_cast<std::array<unsigned char, sizeof(T)>>(val);
+            uint64_t significand = 0;
+            for (size_t i = 0; i < 8; i++) {
+                significand |= uint64_t(bytes[i]) << (8 * i);
+            }
+            const uint32_t sign_exponent = uint32_t(bytes[8]) | (uint32_t(bytes[9]) << 8);
+
+            res.negative = sign_exponent >> 15;
+            fraction = significand & ~(uint64_t(1) << 63);
+            biased_exponent = sign_exponent & 0x7FFF;
+            max_biased_exponent = 0x7FFF;
+        }
+        else {
+            typedef std::conditional_t<sizeof(T) == sizeof(uint32_t), uint32_t, uint64_t> bits_t;
+            constexpr int32_t fraction_bits = traits::digits - 1;
+            constexpr int32_t exponent_bits = sizeof(T) * 8 - 1 - fraction_bits;
+
+            const bits_t bits = std::bit_cast<bits_t>(val);
+
+            res.negative = bits >> (sizeof(T) * 8 - 1);
+            fraction = bits & ((bits_t(1) << fraction_bits) - 1);
+            biased_exponent = uint32_t(bits >> fraction_bits) & ((1u << exponent_bits) - 1);
+            max_biased_exponent = (1u << exponent_bits) - 1;
+        }
+
+        if (biased_exponent == max_biased_exponent) {
+            res.is_nan = fraction != 0;
+            res.is_inf = fraction == 0;
+        }
+        else if (biased_exponent == 0) {
+            res.significand = fraction;
+            res.exponent = traits::min_exponent;
+        }
+        else {
+            res.significand = carrier(fraction) | (carrier(1) << (traits::digits - 1));
+            res.exponent = traits::min_exponent + int32_t(biased_exponent) - 1;
+            res.lower_boundary_closer = fraction == 0 && biased_exponent > 1;
+        }
+
+        return res;
+    }
+
+
+    /**
+     *  Rounds 'g * cp / 2^192' down, and sets the lowest bit if the result is inexact.
+     */
+    template<typename U>
+    constexpr U round_to_odd(const std::array<uint64_t, 3>& g, U cp)
+    {
+        std::array<uint64_t, 4 + (sizeof(U) > sizeof(uint64_t))> r{};
+        if constexpr (sizeof(U) > sizeof(uint64_t)) {
+            r = mul_limbs(g, std::array<uint64_t, 2>{ uint64_t(cp), uint64_t(cp >> 64) });
+        }
+        else {
+            r = mul_limbs(g, std::array<uint64_t, 1>{ cp });
+        }
+
+        U integer_part = r[3];
+        if constexpr (sizeof(U) > sizeof(uint64_t)) {
+            integer_part |= U(r[4]) << 64;
+        }
+
+        // 'g' overestimates the exact power of ten by less than 3 units, therefore the fractional part of an exact
+        // product is below 3 * cp < 2^74.
+        const bool inexact = r[2] != 0 || (r[1] >> 10) != 0;
+        return integer_part | U(inexact);
+    }
+
+
+    /**
+     *  A decimal floating point number: 'significand * 10^exponent'.
+     */
+    template<typename U>
+    struct DecimalFloat
+    {
+        U significand;
+        int32_t exponent;
+    };
+
+
+    /**
+     *  Returns the shortest decimal number which rounds back to the given positive floating point number. If there
+     *  are several, the closest one is chosen.
+     *  This is the Schubfach algorithm by R. Giulietti ("The Schubfach way to render doubles", 2021), with the 192-bit
+     *  powers of ten of 'compute_pow10_significand', which are precise enough for 64-bit significands.
+     */
+    template<typename T>
+    constexpr auto shortest_decimal(const DecomposedFloat<T>& val)
+    {
+        typedef FloatTraits<T> traits;
+        typedef typename traits::carrier U;
+
+        const U c = val.significand;
+        const int32_t q = val.exponent;
+
+        if (0 <= -q && -q < traits::digits && (c & ((U(1) << -q) - 1)) == 0) {
+            // Small integers are exact
+            return DecimalFloat<U>{ c >> -q, 0 };
+        }
+
+        const bool is_even = c % 2 == 0;
+
+        // Boundaries of the rounding interval of the number, times 4
+        const U cbl = 4 * c - 2 + val.lower_boundary_closer;
+        const U cb = 4 * c;
+        const U cbr = 4 * c + 2;
+
+        const int32_t k = val.lower_boundary_closer ? floor_log10_three_quarters_pow2(q) : floor_log10_pow2(q);
+        const int32_t h = q + floor_log2_pow10(-k) + 1; // between 1 and 4
+
+        // Scale all boundaries by 10^-k
+        const std::array<uint64_t, 3> g = compute_pow10_significand(-k);
+        const U vbl = round_to_odd(g, U(cbl << h));
+        const U vb = round_to_odd(g, U(cb << h));
+        const U vbr = round_to_odd(g, U(cbr << h));
+
+        const U lower = vbl + !is_even;
+        const U upper = vbr - !is_even;
+
+        const U s = vb / 4;
+
+        if (s >= 10) {
+            // Try with one digit less
+            const U sp = s / 10;
+            const bool up_inside = lower <= 40 * sp;
+            const bool wp_inside = 40 * sp + 40 <= upper;
+            if (up_inside != wp_inside) {
+                return DecimalFloat<U>{ sp + wp_inside, k + 1 };
+            }
+        }
+
+        const bool u_inside = lower <= 4 * s;
+        const bool w_inside = 4 * s + 4 <= upper;
+        if (u_inside != w_inside) {
+            return DecimalFloat<U>{ s + w_inside, k };
+        }
+
+        // Both s and s + 1 are in the rounding interval: pick the closest
+        const U mid = 4 * s + 2;
+        const bool round_up = vb > mid || (vb == mid && (s & 1) != 0);
+        return DecimalFloat<U>{ s + round_up, k };
+    }
+
+
+    /**
+     *  Removes the trailing zeros of the significand, incrementing the exponent accordingly.
+     */
+    template<typename U>
+    constexpr void remove_trailing_zeros(DecimalFloat<U>& val)
+    {
+        if constexpr (sizeof(U) > sizeof(uint64_t)) {
+            while (val.significand > std::numeric_limits<uint64_t>::max() && val.significand % 10 == 0) {
+                val.significand /= 10;
+                val.exponent++;
+            }
+            if (val.significand <= std::numeric_limits<uint64_t>::max()) {
+                DecimalFloat<uint64_t> small{ uint64_t(val.significand), val.exponent };
+                remove_trailing_zeros(small);
+                val.significand = small.significand;
+                val.exponent = small.exponent;
+            }
+        }
+        else {
+            while (val.significand % 10 == 0) {
+                val.significand /= 10;
+                val.exponent++;
+            }
+        }
+    }
+
+
+    /**
+     *  Writes the exponent part of a number in scientific notation: 'e+5', 'e-12'...
+     */
+    template<typename Str>
+    constexpr void write_exponent(Str& str, size_t& pos, int32_t exp)
+    {
+        str[pos++] = 'e';
+        if (exp >= 0) {
+            str[pos++] = '+';
+        }
+        int_to_char_array(str, pos, exp);
+    }
+
+
+    /**
+     *  Writes the positive decimal number 'significand * 10^exponent', without any trailing zeros in its significand.
+     *  Unless 'scientific' is true, numbers between 1e-4 and 1e5 (excluded) are written without an exponent.
+     */
+    template<typename Str, typename U>
+    constexpr void decimal_float_to_char_array(Str& str, size_t& pos, const DecimalFloat<U>& val,
+                                               bool scientific = false)
+    {
+        const int32_t digits = int32_t(decimal_digits_count(val.significand));
+        const int32_t exp = val.exponent + digits - 1; // Exponent of the first digit
+
+        if (!scientific && -4 <= exp && exp <= 4) {
+            if (exp < 0) {
+                // 0.000ddd
+                str[pos++] = '0';
+                str[pos++] = '.';
+                for (int32_t i = 0; i < -exp - 1; i++) {
+                    str[pos++] = '0';
+                }
+                unsigned_to_char_array(str, pos, val.significand);
+            }
+            else if (exp >= digits - 1) {
+                // ddd000
+                unsigned_to_char_array(str, pos, val.significand);
+                for (int32_t i = 0; i < exp - digits + 1; i++) {
+                    str[pos++] = '0';
+                }
+            }
+            else {
+                // dd.ddd: write all digits one character further, then move the integer part back before the point
+                write_decimal_digits(str, pos + 1, val.significand, digits);
+                for (int32_t i = 0; i <= exp; i++) {
+                    str[pos + i] = str[pos + i + 1];
+                }
+                str[pos + exp + 1] = '.';
+                pos += digits + 1;
+            }
+            return;
+        }
+
+        if (digits == 1) {
+            str[pos++] = char('0' + val.significand);
+        }
+        else {
+            // d.ddd
+            write_decimal_digits(str, pos + 1, val.significand, digits);
+            str[pos] = str[pos + 1];
+            str[pos + 1] = '.';
+            pos += digits + 1;
+        }
+
+        write_exponent(str, pos, exp);
+    }
+
+
+    /**
+     *  Integer type holding floating point numbers rounded to a fixed precision, and the largest precision it allows.
+     */
+#ifdef __SIZEOF_INT128__
+    typedef unsigned __int128 rounded_decimal_t;
+    inline constexpr int32_t max_float_precision = 32;
+#else
+    typedef uint64_t rounded_decimal_t;
+    inline constexpr int32_t max_float_precision = 13;
+#endif
+
+
+    /**
+     *  10^e for 'e <= 38', or 'e <= 19' without 128-bit integers.
+     */
+    constexpr rounded_decimal_t pow10_rounded_decimal(uint32_t e)
+    {
+        if (e <= 19) {
+            return pow10_table<uint64_t>[e];
+        }
+        return rounded_decimal_t(pow10_table<uint64_t>[19]) * pow10_table<uint64_t>[e - 19];
+    }
+
+
+    /**
+     *  Unsigned integer of up to '32 * L' bits, with only the few operations needed by 'round_scaled_decimal'.
+     */
+    template<size_t L>
+    struct BigUInt
+    {
+        std::array<uint32_t, L> limbs{}; // Least significant limb first
+        size_t size = 0;                 // Number of limbs in use, the last one being non-zero
+
+        constexpr explicit BigUInt(uint64_t val)
+        {
+            limbs[0] = uint32_t(val);
+            limbs[1] = uint32_t(val >> 32);
+            size = limbs[1] != 0 ? 2 : limbs[0] != 0;
+        }
+
+        [[nodiscard]]
+        constexpr uint32_t bit_width() const
+        {
+            return size == 0 ? 0 : uint32_t(32 * (size - 1)) + std::bit_width(limbs[size - 1]);
+        }
+
+        [[nodiscard]]
+        constexpr int32_t compare(const BigUInt& other) const
+        {
+            if (size != other.size) {
+                return size < other.size ? -1 : 1;
+            }
+            for (size_t i = size; i-- > 0;) {
+                if (limbs[i] != other.limbs[i]) {
+                    return limbs[i] < other.limbs[i] ? -1 : 1;
+                }
+            }
+            return 0;
+        }
+
+        constexpr void multiply(uint32_t x)
+        {
+            uint64_t carry = 0;
+            for (size_t i = 0; i < size; i++) {
+                carry += uint64_t(limbs[i]) * x;
+                limbs[i] = uint32_t(carry);
+                carry >>= 32;
+            }
+            if (carry != 0) {
+                limbs[size++] = uint32_t(carry);
+            }
+        }
+
+        constexpr void multiply_pow5(uint32_t e)
+        {
+            constexpr uint32_t pow5_13 = 1220703125; // The largest power of 5 fitting in 32 bits
+            for (; e >= 13; e -= 13) {
+                multiply(pow5_13);
+            }
+            if (e > 0) {
+                multiply(uint32_t(pow5_table[e]));
+            }
+        }
+
+        constexpr void shift_left(uint32_t bits)
+        {
+            if (size == 0) {
+                return;
+            }
+            const size_t limb_shift = bits / 32;
+            const uint32_t bit_shift = bits % 32;
+            const uint32_t top = bit_shift == 0 ? 0 : limbs[size - 1] >> (32 - bit_shift);
+            for (size_t i = size; i-- > 0;) {
+                const uint32_t low = bit_shift == 0 || i == 0 ? 0 : limbs[i - 1] >> (32 - bit_shift);
+                limbs[i + limb_shift] = (limbs[i] << bit_shift) | low;
+            }
+            for (size_t i = 0; i < limb_shift; i++) {
+                limbs[i] = 0;
+            }
+            size += limb_shift;
+            if (top != 0) {
+                limbs[size++] = top;
+            }
+        }
+
+        constexpr void shift_right_one()
+        {
+            for (size_t i = 0; i < size; i++) {
+                limbs[i] = (limbs[i] >> 1) | (i + 1 < size ? limbs[i + 1] << 31 : 0);
+            }
+            if (size > 0 && limbs[size - 1] == 0) {
+                size--;
+            }
+        }
+
+        /**
+         *  Divides by 'x', and returns the remainder.
+         */
+        constexpr uint32_t divide(uint32_t x)
+        {
+            uint64_t remainder = 0;
+            for (size_t i = size; i-- > 0;) {
+                const uint64_t current = (remainder << 32) | limbs[i];
+                limbs[i] = uint32_t(current / x);
+                remainder = current % x;
+            }
+            while (size > 0 && limbs[size - 1] == 0) {
+                size--;
+            }
+            return uint32_t(remainder);
+        }
+
+        /**
+         *  Subtracts a number smaller or equal to this one.
+         */
+        constexpr void subtract(const BigUInt& other)
+        {
+            uint64_t borrow = 0;
+            for (size_t i = 0; i < size; i++) {
+                const uint64_t sub = uint64_t(i < other.size ? other.limbs[i] : 0) + borrow;
+                borrow = limbs[i] < sub;
+                limbs[i] = uint32_t(limbs[i] - sub);
+            }
+            while (size > 0 && limbs[size - 1] == 0) {
+                size--;
+            }
+        }
+    };
+
+
+    /**
+     *  Returns 'q + 1' if the fraction 'r / d' is above one half, or exactly one half with 'q' odd. Otherwise 'q'.
+     */
+    template<typename U>
+    constexpr rounded_decimal_t round_to_nearest_even(rounded_decimal_t q, U r, U d)
+    {
+        // 'r < d', so '2 * r' would only overflow if 'd' used the most significant bit, which it never does
+        return q + (2 * r > d || (2 * r == d && (q & 1) != 0));
+    }
+
+
+    /**
+     *  Returns 'val * 10^k' exactly rounded to the nearest integer, ties to even. The result must be below 2^127
+     *  (or 2^63 without 128-bit integers).
+     *  Most values fit in 128-bit integers, others go through arbitrary precision arithmetic.
+     */
+    template<typename T>
+    constexpr rounded_decimal_t round_scaled_decimal(const DecomposedFloat<T>& val, int32_t k)
+    {
+        typedef FloatTraits<T> traits;
+
+        const uint64_t m = uint64_t(val.significand);
+        const int32_t t = val.exponent + k; // 'val * 10^k == m * 5^k * 2^t'
+
+#ifdef __SIZEOF_INT128__
+        typedef unsigned __int128 u128;
+        constexpr int32_t max_pow5 = int32_t(pow5_table.size()) - 1; // 5^26 < 2^61
+
+        if (0 <= k && k <= max_pow5) {
+            const u128 p = u128(m) * pow5_table[k]; // < 2^125
+            if (t >= 0) {
+                return p << t;
+            }
+            if (t <= -126) {
+                return 0; // Below one half
+            }
+            const u128 mask = (u128(1) << -t) - 1;
+            return round_to_nearest_even(p >> -t, p & mask, mask + 1);
+        }
+        else if (-max_pow5 <= k && k < 0) {
+            const u128 d = pow5_table[-k];
+            if (0 <= t && t < 64) {
+                const u128 n = u128(m) << t;
+                return round_to_nearest_even(n / d, n % d, d);
+            }
+            if (-64 <= t && t < 0) {
+                const u128 ds = d << -t; // < 2^125
+                return round_to_nearest_even(m / ds, m % ds, ds);
+            }
+        }
+#endif
+
+        // Large enough for 'm * 5^k * 2^t' and for '5^-k * 2^-t', even for the largest and smallest values
+        constexpr size_t L = (-traits::min_exponent + traits::digits + 192) / 32 + 2;
+
+        BigUInt<L> num(m);
+        BigUInt<L> den(1);
+        if (k >= 0) {
+            num.multiply_pow5(k);
+        }
+        else {
+            den.multiply_pow5(-k);
+        }
+        if (t >= 0) {
+            num.shift_left(t);
+        }
+        else {
+            den.shift_left(-t);
+        }
+
+        // Binary long division
+        rounded_decimal_t q = 0;
+        const int32_t shift = int32_t(num.bit_width()) - int32_t(den.bit_width());
+        if (shift >= 0) {
+            den.shift_left(shift);
+            for (int32_t i = shift; i >= 0; i--) {
+                q <<= 1;
+                if (num.compare(den) >= 0) {
+                    num.subtract(den);
+                    q |= 1;
+                }
+                if (i > 0) {
+                    den.shift_right_one();
+                }
+            }
+        }
+
+        // 'num' is now the remainder
+        num.shift_left(1);
+        const int32_t half = num.compare(den);
+        return q + (half > 0 || (half == 0 && (q & 1) != 0));
+    }
+
+
+    /**
+     *  Writes exactly 'digits' decimal digits of 'val', padded with leading zeros. Up to 38 digits.
+     */
+    template<typename Str>
+    constexpr void write_rounded_decimal_digits(Str& str, size_t pos, rounded_decimal_t val,
+                                                uint32_t digits)
+    {
+        if (digits > 19) {
+            constexpr uint64_t chunk = pow10_table<uint64_t>[19];
+            write_decimal_digits(str, pos + digits - 19, uint64_t(val % chunk), 19);
+            write_decimal_digits(str, pos, uint64_t(val / chunk), digits - 19);
+        }
+        else {
+            write_decimal_digits(str, pos, uint64_t(val), digits);
+        }
+    }
+
+
+    /**
+     *  Writes all the digits of the positive number 'm * 2^e', for 'e >= 0', which can be far above 64 bits.
+     */
+    template<typename Str, typename T>
+    constexpr void float_integer_to_char_array(Str& str, size_t& pos, const DecomposedFloat<T>& val)
+    {
+        constexpr size_t L = std::numeric_limits<T>::max_exponent / 32 + 2;
+        BigUInt<L> integer(uint64_t(val.significand));
+        integer.shift_left(uint32_t(val.exponent));
+
+        // Groups of 9 digits, least significant first
+        constexpr uint32_t group = 1000000000;
+        std::array<uint32_t, (std::numeric_limits<T>::max_exponent10 + 1) / 9 + 1> groups{};
+        size_t count = 0;
+        do {
+            groups[count++] = integer.divide(group);
+        } while (integer.size > 0);
+
+        unsigned_to_char_array(str, pos, groups[count - 1]);
+        for (size_t i = count - 1; i-- > 0;) {
+            write_decimal_digits(str, pos, groups[i], 9);
+            pos += 9;
+        }
+    }
+
+
+    /**
+     *  Writes the positive number with exactly 'precision' digits after the decimal point, rounded to the nearest
+     *  value (ties to even). In fixed notation, all the digits of the integer part are written.
+     */
+    template<bool scientific, int32_t precision, typename Str, typename T>
+    constexpr void fixed_precision_to_char_array(Str& str, size_t& pos, const DecomposedFloat<T>& val)
+    {
+        constexpr rounded_decimal_t scale = pow10_rounded_decimal(precision);
+
+        // Writes the decimal point and the fraction digits, below 'scale'
+        const auto write_fraction = [&](rounded_decimal_t fraction) {
+            if constexpr (precision > 0) {
+                str[pos++] = '.';
+                write_rounded_decimal_digits(str, pos, fraction, precision);
+                pos += precision;
+            }
+        };
+
+        // Writes 'integer + q / scale', then the fraction digits. 128-bit divisions are avoided when possible.
+        const auto write_digits = [&](uint64_t integer, rounded_decimal_t q) {
+            rounded_decimal_t integer_part, fraction;
+            if (precision <= 19 && q <= std::numeric_limits<uint64_t>::max()) {
+                integer_part = uint64_t(q) / uint64_t(scale);
+                fraction = uint64_t(q) % uint64_t(scale);
+            }
+            else {
+                integer_part = q / scale;
+                fraction = q % scale;
+            }
+            unsigned_to_char_array(str, pos, integer + uint64_t(integer_part));
+            write_fraction(fraction);
+        };
+
+        if constexpr (!scientific) {
+            if (val.exponent >= 0) {
+                // An integer, with only zeros after the decimal point
+                float_integer_to_char_array(str, pos, val);
+                write_fraction(0);
+                return;
+            }
+
+            // The integer part fits in 64 bits. Only the fraction is scaled, with the lowest bit of the integer part,
+            // so that the rounding still knows whether the integer part is even.
+            const int32_t fraction_bits = -val.exponent;
+            const uint64_t m = uint64_t(val.significand);
+            const uint64_t even_integer = fraction_bits < 64 ? (m >> fraction_bits) & ~uint64_t(1) : 0;
+            DecomposedFloat<T> rest = val;
+            rest.significand = fraction_bits < 64 ? m - (even_integer << fraction_bits) : m;
+            write_digits(even_integer, round_scaled_decimal(rest, precision));
+        }
+        else {
+            rounded_decimal_t q = 0;
+            int32_t exp = 0; // Exponent of the first digit
+
+            if (val.significand != 0) {
+                // Either the exponent of the first digit, or one below it
+                exp = floor_log10_pow2(val.exponent + int32_t(utils::bit_width(val.significand)) - 1);
+
+                q = round_scaled_decimal(val, precision - exp);
+                while (q >= scale * 10) {
+                    // The estimated exponent was too small, or the rounding added one digit
+                    exp++;
+                    q = round_scaled_decimal(val, precision - exp);
+                }
+            }
+
+            write_digits(0, q);
+            write_exponent(str, pos, exp);
+        }
+    }
+}
+
+
+namespace cst_fmt
+{
+    /**
+     * A format specifier, parsed from the format string: '%.3f' gives '{ 'f', 3 }'.
+     */
+    struct FormatSpec
+    {
+        char type = '\0';
+
+        // Number of digits after the decimal point, or -1 if not specified
+        int32_t precision = -1;
+
+        // Minimum number of characters, padded with spaces, or 0 if not specified
+        int32_t width = 0;
+
+        // Pad on the right instead of the left
+        bool left_align = false;
+
+        // Inserted between each group of three digits with '%'d', or '\0' if not specified
+        char separator = '\0';
+    };
+
+
+    /**
+     * The place of an argument in a format string: the number of literal characters of the format string before it,
+     * and the maximum number of characters it can be formatted to.
+     */
+    struct FormatHole
+    {
+        size_t literal_offset;
+        size_t max_width;
+        FormatSpec spec;
+    };
+
+
+    /**
+     * A constant size, string-like object.
+     */
+    template<size_t N>
+    class FormattedCharArray : public std::array<char, N>
+    {
+        using PackedSize = utils::small_size_t<N>;
+        static constexpr PackedSize truncated_flag = PackedSize(1) << (std::numeric_limits<PackedSize>::digits - 1);
+
+        // The effective size, with the truncation flag in the highest bit
+        PackedSize m_size = 0;
+
+    public:
+        using std::array<char, N>::data;
+
+        constexpr void set_effective_size(size_t effective_size)
+        {
+            m_size = PackedSize(effective_size) | (m_size & truncated_flag);
+        }
+
+        [[nodiscard]]
+        constexpr size_t effective_size() const { return m_size & PackedSize(~truncated_flag); }
+
+        constexpr void set_truncated() { m_size |= truncated_flag; }
+
+        /**
+         * True if a string argument with the 'cst_fmt::Truncation::report' policy was longer than its holder.
+         */
+        [[nodiscard]]
+        constexpr bool is_truncated() const { return (m_size & truncated_flag) != 0; }
+
+        [[nodiscard]]
+        constexpr const char* cstr() const { return data(); }
+
+        [[nodiscard]]
+        constexpr std::string_view view() const { return std::string_view(data(), effective_size()); }
+
+
+        [[nodiscard]]
+#ifndef __clang__
+        // Clang doesn't support constexpr string constructors for now
+        constexpr
+#endif
+        std::string str() const { return std::string(data(), effective_size()); }
+
+
+        /**
+         * Copies the result to an array of M characters, '\0' included. If it doesn't fit, it is cut and marked as
+         * truncated.
+         */
+        template<size_t M>
+        [[nodiscard]]
+        constexpr FormattedCharArray<M> trim() const
+        {
+            static_assert(M > 0, "The trimmed array must have room for the '\\0'");
+            FormattedCharArray<M> trimmed;
+            utils::init_buffer(trimmed);
+            const size_t size = effective_size() < M - 1 ? effective_size() : M - 1;
+            for (size_t i = 0; i < size; i++) {
+                trimmed[i] = (*this)[i];
+            }
+            trimmed[size] = '\0';
+            trimmed.set_effective_size(size);
+            if (is_truncated() || size < effective_size()) {
+                trimmed.set_truncated();
+            }
+            return trimmed;
+        }
+
+
+        template<typename T>
+            requires utils::is_const_iterable<T>
+        constexpr bool operator==(const T& array) const
+        {
+            if (effective_size() != array.size()) {
+                return false;
+            }
+            // We iterate on the other array since our array size is bigger than the effective size
+            return std::equal(array.cbegin(), array.cend(), this->cbegin());
+        }
+
+
+        template<typename T>
+            requires utils::is_const_iterable<T>
+        constexpr bool operator!=(const T& array) const
+        {
+            if (effective_size() != array.size()) {
+                return true;
+            }
+            // We iterate on the other array since our array size is bigger than the effective size
+            return !std::equal(array.cbegin(), array.cend(), this->cbegin());
+        }
+    };
+
+
+    template<size_t N>
+    std::ostream& operator<<(std::ostream& os, const FormattedCharArray<N>& str)
+    {
+        os << str.view();
+        return os;
+    }
+}
+
+
+/*
+ * Additional formats can be specified here by using the same structure.
+ * 'exact_str_length' is optional: without it, 'cst_fmt::formatted_size' formats the value to measure it.
+ */
+namespace cst_fmt::specialisation
+{
+	//
+	// %d -> decimal number
+	//
+	
+	
+	template<FormatSpec spec>
+	concept decimal_format = spec.type == 'd';
+	
+	
+    template<FormatSpec spec, typename T>
+    	requires decimal_format<spec> && std::is_integral_v<T>
+    consteval size_t formatted_str_length()
+    {
+        // One separator for each group of three digits after the first one
+        constexpr size_t separators = spec.separator != '\0' ? std::numeric_limits<T>::digits10 / 3 : 0;
+        if constexpr (std::is_signed_v<T>) {
+            // Add one space for a potential minus sign
+            return std::numeric_limits<T>::digits10 + 2 + separators;
+        }
+        else {
+            return std::numeric_limits<T>::digits10 + 1 + separators;
+        }
+    }
+
+
+    template<FormatSpec spec, typename T>
+    	requires decimal_format<spec> && (!std::is_integral_v<T>)
+    consteval size_t formatted_str_length()
+    {
+        static_assert(spec.type == '\0', "'%d' expected an integral type");
+        return 0;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+    	requires decimal_format<spec> && std::is_integral_v<T> && (!std::same_as<T, bool>)
+    constexpr void format_to_str(Str& str, size_t& pos, T val)
+    {
+        if constexpr (spec.separator != '\0') {
+            utils::grouped_int_to_char_array<spec.separator>(str, pos, val);
+        }
+        else {
+            utils::int_to_char_array(str, pos, val);
+        }
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+     	requires decimal_format<spec> && std::is_integral_v<T> && std::same_as<T, bool>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        str[pos++] = val ? '1' : '0';
+    }
+
+
+
+    /**
+     * Length of the result of 'format_to_str', without writing it.
+     */
+    template<FormatSpec spec, typename T>
+        requires decimal_format<spec> && std::is_integral_v<T>
+    constexpr size_t exact_str_length(const T& val)
+    {
+        if constexpr (std::same_as<T, bool>) {
+            return 1;
+        }
+        else {
+            typedef typename std::make_unsigned<T>::type uT;
+            uT u_val = val;
+            size_t sign = 0;
+            if constexpr (std::is_signed_v<T>) {
+                sign = val < 0;
+                u_val = sign ? uT(uT(0) - u_val) : u_val;
+            }
+            const uint32_t digits = u_val == 0 ? 1 : utils::decimal_digits_count(u_val);
+            return sign + digits + (spec.separator != '\0' ? utils::digit_groups_separators(digits) : 0);
+        }
+    }
+    
+    
+    template<FormatSpec spec, typename Str, typename T>
+     	requires decimal_format<spec> && (!std::is_integral_v<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
+    {
+    	static_assert(spec.type == '\0', "'%d' expected an integral type");
+    }
+    
+    
+    //
+    // %x -> hexadecimal number
+    //
+    
+    
+	template<FormatSpec spec>
+	concept hex_format = spec.type == 'x';
+	
+    
+    template<FormatSpec spec, typename T>
+    	requires hex_format<spec> && std::is_integral_v<T>
+    consteval size_t formatted_str_length()
+    {
+    	// +2 for the '0x' prefix
+        return 2 + std::numeric_limits<T>::digits / 4 + 1;
+    }
+    
+    
+    template<FormatSpec spec, typename T>
+    	requires hex_format<spec> && (!std::is_integral_v<T>)
+    consteval size_t formatted_str_length()
+    {
+        static_assert(spec.type == '\0', "'%x' expected an integral type");
+        return 0;
+    }
+    
+    
+    template<FormatSpec spec, typename Str, typename T>
+    	requires hex_format<spec> && std::is_integral_v<T> && (!std::same_as<T, bool>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        typedef typename std::make_unsigned<T>::type uT;
+
+        const uT u_val = static_cast<uT>(val);
+        const uint32_t val_digits = val == 0 ? 1 : utils::hexadecimal_digits_count(u_val);
+
+        str[pos++] = '0';
+        str[pos++] = 'x';
+
+        if constexpr (sizeof(uT) <= sizeof(uint64_t)) {
+            if (!std::is_constant_evaluated()) {
+                char digits[16];
+                utils::hex_u64_to_chars(digits, u_val);
+                std::memcpy(&str[pos], digits + 16 - val_digits, val_digits);
+                pos += val_digits;
+                return;
+            }
+        }
+
+        utils::write_hex_digits(str, pos, u_val, val_digits);
+        pos += val_digits;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+     	requires hex_format<spec> && std::is_integral_v<T> && std::same_as<T, bool>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        str[pos++] = '0';
+        str[pos++] = 'x';
+        str[pos++] = val ? '1' : '0';
+    }
+
+
+
+    template<FormatSpec spec, typename T>
+        requires hex_format<spec> && std::is_integral_v<T>
+    constexpr size_t exact_str_length(const T& val)
+    {
+        if constexpr (std::same_as<T, bool>) {
+            return 3;
+        }
+        else {
+            typedef typename std::make_unsigned<T>::type uT;
+            const uT u_val = static_cast<uT>(val);
+            return 2 + (val == 0 ? 1 : utils::hexadecimal_digits_count(u_val));
+        }
+    }
+    
+    
+    template<FormatSpec spec, typename Str, typename T>
+     	requires hex_format<spec> && (!std::is_integral_v<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
+    {
+    	static_assert(spec.type == '\0', "'%x' expected an integral type");
+    }
+
+
+    //
+    // %b -> binary number
+    //
+
+
+    template<FormatSpec spec>
+    concept binary_format = spec.type == 'b';
+
+
+    template<FormatSpec spec, typename T>
+        requires binary_format<spec> && std::is_integral_v<T>
+    consteval size_t formatted_str_length()
+    {
+        // +2 for the '0b' prefix, and the sign bit is a digit of the unsigned value
+        return 2 + std::numeric_limits<T>::digits + std::is_signed_v<T>;
+    }
+
+
+    template<FormatSpec spec, typename T>
+        requires binary_format<spec> && (!std::is_integral_v<T>)
+    consteval size_t formatted_str_length()
+    {
+        static_assert(spec.type == '\0', "'%b' expected an integral type");
+        return 0;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires binary_format<spec> && std::is_integral_v<T> && (!std::same_as<T, bool>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        typedef typename std::make_unsigned<T>::type uT;
+
+        const uT u_val = static_cast<uT>(val);
+        const uint32_t val_digits = val == 0 ? 1 : uint32_t(std::bit_width(u_val));
+
+        str[pos++] = '0';
+        str[pos++] = 'b';
+
+        if constexpr (sizeof(uT) <= sizeof(uint64_t)) {
+            if (!std::is_constant_evaluated()) {
+                char digits[64];
+                utils::binary_u64_to_chars(digits, u_val);
+                std::memcpy(&str[pos], digits + 64 - val_digits, val_digits);
+                pos += val_digits;
+                return;
+            }
+        }
+
+        utils::write_binary_digits(str, pos, u_val, val_digits);
+        pos += val_digits;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires binary_format<spec> && std::is_integral_v<T> && std::same_as<T, bool>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        str[pos++] = '0';
+        str[pos++] = 'b';
+        str[pos++] = val ? '1' : '0';
+    }
+
+
+    template<FormatSpec spec, typename T>
+        requires binary_format<spec> && std::is_integral_v<T>
+    constexpr size_t exact_str_length(const T& val)
+    {
+        if constexpr (std::same_as<T, bool>) {
+            return 3;
+        }
+        else {
+            typedef typename std::make_unsigned<T>::type uT;
+            return 2 + (val == 0 ? 1 : size_t(std::bit_width(static_cast<uT>(val))));
+        }
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires binary_format<spec> && (!std::is_integral_v<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
+    {
+        static_assert(spec.type == '\0', "'%b' expected an integral type");
+    }
+
+
     //
-    // %x -> hexadecimal number
+    // %o -> octal number
     //
-    
-    
-	template<char fmt>
-	concept hex_format = fmt == 'x';
-	
-    
-    template<char fmt, typename T>
-    	requires hex_format<fmt> && std::is_integral_v<T>
+
+
+    template<FormatSpec spec>
+    concept octal_format = spec.type == 'o';
+
+
+    template<FormatSpec spec, typename T>
+        requires octal_format<spec> && std::is_integral_v<T>
     consteval size_t formatted_str_length()
     {
-    	// +2 for the '0x' prefix
-        return 2 + std::numeric_limits<T>::digits / 4 + 1;
+        // +2 for the '0o' prefix, and the sign bit is a digit of the unsigned value
+        return 2 + (std::numeric_limits<T>::digits + std::is_signed_v<T> + 2) / 3;
     }
-    
-    
-    template<char fmt, typename T>
-    	requires hex_format<fmt> && (!std::is_integral_v<T>)
+
+
+    template<FormatSpec spec, typename T>
+        requires octal_format<spec> && (!std::is_integral_v<T>)
     consteval size_t formatted_str_length()
     {
-        static_assert(fmt == '\0', "'%x' expected an integral type");
+        static_assert(spec.type == '\0', "'%o' expected an integral type");
         return 0;
     }
-    
-    
-    template<char fmt, size_t N, typename T>
-    	requires hex_format<fmt> && std::is_integral_v<T> && (!std::same_as<T, bool>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires octal_format<spec> && std::is_integral_v<T> && (!std::same_as<T, bool>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
     {
         typedef typename std::make_unsigned<T>::type uT;
 
-        uT u_val = static_cast<uT>(val);
-        uint32_t val_digits = 0;
-        
-        if (val == 0) {
-        	val_digits = 1;
-        }
-        else {
-        	val_digits = utils::hexadecimal_digits_count(u_val);
-        }
-        
-        uT a = utils::const_16_pow<uT>(val_digits - 1);
-        
+        const uT u_val = static_cast<uT>(val);
+        const uint32_t val_digits = val == 0 ? 1 : (uint32_t(std::bit_width(u_val)) + 2) / 3;
+
         str[pos++] = '0';
-        str[pos++] = 'x';
-        for (uint32_t i = 0; i < val_digits; i++) {
-        	char c = '0' + (u_val / a);
-        	if (c > '9') {
-        		c += 7; // Shift to the 'A' to 'F' range
-        	}
-            str[pos++] = c;
-            u_val = u_val % a;
-            a /= 16;
+        str[pos++] = 'o';
+
+        if constexpr (sizeof(uT) <= sizeof(uint64_t)) {
+            if (!std::is_constant_evaluated()) {
+                char digits[24];
+                utils::octal_u64_to_chars(digits, u_val);
+                std::memcpy(&str[pos], digits + 24 - val_digits, val_digits);
+                pos += val_digits;
+                return;
+            }
         }
+
+        utils::write_octal_digits(str, pos, u_val, val_digits);
+        pos += val_digits;
     }
 
 
-    template<char fmt, size_t N, typename T>
-     	requires hex_format<fmt> && std::is_integral_v<T> && std::same_as<T, bool>
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+    template<FormatSpec spec, typename Str, typename T>
+        requires octal_format<spec> && std::is_integral_v<T> && std::same_as<T, bool>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
     {
         str[pos++] = '0';
-        str[pos++] = 'x';
+        str[pos++] = 'o';
         str[pos++] = val ? '1' : '0';
     }
-    
-    
-    template<char fmt, size_t N, typename T>
-     	requires hex_format<fmt> && (!std::is_integral_v<T>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+
+
+    template<FormatSpec spec, typename T>
+        requires octal_format<spec> && std::is_integral_v<T>
+    constexpr size_t exact_str_length(const T& val)
+    {
+        if constexpr (std::same_as<T, bool>) {
+            return 3;
+        }
+        else {
+            typedef typename std::make_unsigned<T>::type uT;
+            return 2 + (val == 0 ? 1 : (size_t(std::bit_width(static_cast<uT>(val))) + 2) / 3);
+        }
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires octal_format<spec> && (!std::is_integral_v<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
     {
-    	static_assert(fmt == '\0', "'%x' expected an integral type");
+        static_assert(spec.type == '\0', "'%o' expected an integral type");
     }
 
 
@@ -380,166 +2387,104 @@ namespace cst_fmt::specialisation
     //
 
 
-    template<char fmt>
-    concept float_format = fmt == 'f';
+    template<FormatSpec spec>
+    concept float_format = spec.type == 'f' || spec.type == 'e';
 
 
-    template<char fmt, typename T>
-        requires float_format<fmt> && std::is_floating_point_v<T>
+    template<FormatSpec spec, typename T>
+        requires float_format<spec> && std::is_floating_point_v<T>
     consteval size_t formatted_str_length()
     {
-        // sign + comma + number of digits for exact representation + exponent 'e' + exponent sign + exponent length
-        return 1 + 1 + std::numeric_limits<T>::max_digits10 + 1 + 1 +
+        // exponent 'e' + exponent sign + exponent length
+        constexpr size_t exponent_length = 1 + 1 +
                 utils::decimal_digits_count(uint32_t(std::numeric_limits<T>::max_exponent10));
+
+        if constexpr (spec.precision < 0) {
+            // sign + comma + number of digits for exact representation + exponent
+            return 1 + 1 + std::numeric_limits<T>::max_digits10 + exponent_length;
+        }
+        else {
+            static_assert(spec.precision <= utils::max_float_precision, "Floating point precision too large");
+
+            // comma + digits after it
+            constexpr size_t fraction_length = spec.precision > 0 ? 1 + spec.precision : 0;
+
+            // sign + digits
+            if constexpr (spec.type == 'f') {
+                // All the digits of the integer part, up to the largest value
+                return 1 + std::numeric_limits<T>::max_exponent10 + 1 + fraction_length;
+            }
+            else {
+                return 1 + 1 + fraction_length + exponent_length;
+            }
+        }
     }
 
 
-    template<char fmt, typename T>
-        requires float_format<fmt> && (!std::is_floating_point_v<T>)
+    template<FormatSpec spec, typename T>
+        requires float_format<spec> && (!std::is_floating_point_v<T>)
     consteval size_t formatted_str_length()
     {
-        static_assert(fmt == '\0', "'%f' expected an floating point type");
+        static_assert(spec.type == '\0', "'%f' expected an floating point type");
         return 0;
     }
     
     
-    template<char fmt, size_t N, typename T>
-        requires float_format<fmt> && std::is_floating_point_v<T>
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+    template<FormatSpec spec, typename Str, typename T>
+        requires float_format<spec> && std::is_floating_point_v<T>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
     {
-        constexpr uint32_t resolution_digits = std::numeric_limits<T>::max_digits10; // Number of digits to exactly represent a number
-        constexpr uint32_t max_digits = 6; // Precision at which the number is formatted to
+        constexpr bool scientific = spec.type == 'e';
+
+        const auto decomposed = utils::decompose_float(val);
 
         // Handle edge cases: NaN and inf. 0 is also optimized.
-        if (std::signbit(val)) { // And not 'val < 0', so that values like '-nan' can be handled properly
+        if (decomposed.negative) { // And not 'val < 0', so that values like '-nan' can be handled properly
             str[pos++] = '-';
         }
 
-        if (std::isnan(val)) {
-            str[pos++] = 'n';
-            str[pos++] = 'a';
-            str[pos++] = 'n';
+        if (decomposed.is_nan || decomposed.is_inf) {
+            // Copied at once: GCC outlines single character writes on this cold path, merges the outlined copies of
+            // the different string types, and then reports the writes to a string with the bounds of another one
+            const char* special = decomposed.is_nan ? "nan" : "inf";
+            if (std::is_constant_evaluated()) {
+                for (size_t i = 0; i < 3; i++) {
+                    str[pos + i] = special[i];
+                }
+            }
+            else {
+                std::memcpy(&str[pos], special, 3);
+            }
+            pos += 3;
             return;
         }
 
-        if (std::isinf(val)) {
-            str[pos++] = 'i';
-            str[pos++] = 'n';
-            str[pos++] = 'f';
+        if constexpr (spec.precision >= 0) {
+            // Exactly rounded to the precision
+            utils::fixed_precision_to_char_array<scientific, spec.precision>(str, pos, decomposed);
             return;
         }
 
-        if (val == 0) {
+        if (decomposed.significand == 0) {
             str[pos++] = '0';
-            return;
-        }
-
-        const T val_abs = std::abs(val);
-
-        // Get the base 10 exponent (rounded down) and mantissa
-        int exp = std::log10(val_abs);
-
-        // Extract the mantissa as a number between 0 and 10
-        T mantissa = val_abs;
-        if (exp == std::numeric_limits<T>::min_exponent10) {
-            // If 'val' is at the normalized limit of its type, then we would go to subnormal values when dividing by
-            // 10^exp and loose precision.
-            // TODO : still not fixed...
-            mantissa *= std::pow(T(10), resolution_digits);
-            mantissa /= std::pow(T(10), exp);
-            mantissa /= std::pow(T(10), resolution_digits);
-            mantissa *= 10;
-            exp -= 1;
-        }
-        else {
-            mantissa /= std::pow(T(10), exp);
-            mantissa *= 10;
-            exp -= 1;
-        }
-
-        // Round the mantissa to the number of digits of precision wanted
-        mantissa = std::round(mantissa * std::pow(T(10), resolution_digits)) / std::pow(T(10), resolution_digits);
-
-        bool whole_number = false;
-        uint32_t int_mantissa = 0;
-        if (-4 <= exp && exp <= 4) {
-            // Display the whole number without an exponent
-            // TODO : fix the problem with the precision here
-            mantissa *= std::pow(10, exp);
-            int_mantissa = std::floor(mantissa);
-            whole_number = true;
-            exp = 0;
-        }
-        else {
-            int_mantissa = std::floor(mantissa);
-            if (int_mantissa >= 10) {
-                // Leave only one digit in the integer part
-                int_mantissa /= 10;
-                mantissa /= 10;
-                exp += 1;
-            }
-        }
-
-        mantissa -= int_mantissa;
-
-        uint32_t dec_mantissa = 0;
-        int leading_zeros = 0;
-
-        if (mantissa != 0) {
-            // Fill the rest of the available digits with the decimal part
-            uint32_t digits = uint32_t(std::floor(std::log10(int_mantissa))) + 1;
-            uint32_t available_digits = max_digits - digits;
-            if (whole_number) {
-                int dec_exp = std::log10(mantissa);
-                leading_zeros -= dec_exp;
-                mantissa = mantissa / std::pow(T(10), dec_exp);
-            }
-            mantissa = std::round(mantissa * std::pow(10, available_digits));
-            dec_mantissa = mantissa;
-            leading_zeros += available_digits - 1 - std::floor(std::log10(mantissa));
-
-            if (leading_zeros < 0) {
-                // The rounded decimal part is either 0 or 1. In all cases there is nothing to print.
-                if (dec_mantissa > 0) {
-                    int_mantissa += 1;
-                    if (int_mantissa >= 10) {
-                        // Leave only one digit in the integer part
-                        int_mantissa /= 10;
-                        exp += 1;
-                    }
-                }
-                dec_mantissa = 0;
-            }
-        }
-
-        utils::int_to_char_array(str, pos, int_mantissa);
-
-        if (dec_mantissa != 0) {
-            str[pos++] = '.';
-
-            // Write leading zeros
-            for (int i = 0; i < leading_zeros; i++) {
-                str[pos++] = '0';
+            if constexpr (scientific) {
+                utils::write_exponent(str, pos, 0);
             }
-
-            utils::int_to_char_array<true>(str, pos, dec_mantissa);
+            return;
         }
 
-        if (exp != 0) {
-            str[pos++] = 'e';
-            if (exp > 0) {
-                str[pos++] = '+';
-            }
-            utils::int_to_char_array(str, pos, exp);
-        }
+        // Shortest representation which can be parsed back to the same value
+        auto decimal = utils::shortest_decimal(decomposed);
+        utils::remove_trailing_zeros(decimal);
+        utils::decimal_float_to_char_array(str, pos, decimal, scientific);
     }
 	
 
-    template<char fmt, size_t N, typename T>
-        requires float_format<fmt> && (!std::is_floating_point_v<T>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+    template<FormatSpec spec, typename Str, typename T>
+        requires float_format<spec> && (!std::is_floating_point_v<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
     {
-        static_assert(fmt == '\0', "'%f' expected an floating point type");
+        static_assert(spec.type == '\0', "'%f' expected an floating point type");
     }
 
     
@@ -548,15 +2493,15 @@ namespace cst_fmt::specialisation
     //
     
     
-    template<char fmt>
-    concept string_format = fmt == 's';
+    template<FormatSpec spec>
+    concept string_format = spec.type == 's';
     
     
     // char array
     
     
-    template<char fmt, typename T>
-    	requires string_format<fmt> && (utils::is_char_array_holder<T> || utils::is_dyn_str_holder<T>)
+    template<FormatSpec spec, typename T>
+    	requires string_format<spec> && (utils::is_char_array_holder<T> || utils::is_dyn_str_holder<T>)
     consteval size_t formatted_str_length()
     {
     	if constexpr (T::size() == 0) {
@@ -568,23 +2513,64 @@ namespace cst_fmt::specialisation
     }
     
     
-    template<char fmt, size_t N, typename T>
-    	requires string_format<fmt> && (utils::is_char_array_holder<T> || utils::is_dyn_str_holder<T>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+    template<FormatSpec spec, typename Str, typename T>
+    	requires string_format<spec> && (utils::is_char_array_holder<T> || utils::is_dyn_str_holder<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
     {
         if constexpr (T::size() > 0) {
             constexpr size_t STR_LEN = T::size();
-            for (size_t i = 0; i < STR_LEN; i++) {
-                char c;
-                if constexpr (utils::is_char_array_holder<T>) {
-                	c = T::get()[i];
+            if constexpr (utils::is_char_array_holder<T>) {
+                constexpr size_t length = std::find(T::get(), T::get() + STR_LEN, '\0') - T::get();
+                for (size_t i = 0; i < length; i++) {
+                    str[pos + i] = T::get()[i];
+                }
+                pos += length;
+            }
+            else {
+                size_t length = 0;
+                if (std::is_constant_evaluated()) {
+                    while (length < STR_LEN && val.str[length] != '\0') {
+                        str[pos + length] = val.str[length];
+                        length++;
+                    }
                 }
                 else {
-                	c = val.str[i];
+                    length = utils::bounded_str_length<STR_LEN>(val.str);
+                    std::memcpy(&str[pos], val.str, length);
+                }
+
+                if constexpr (T::truncation() != Truncation::silent) {
+                    // Only a string of N characters may be longer: then it must still be terminated
+                    utils::apply_truncation<T::truncation(), STR_LEN>(str, pos,
+                                                                      length == STR_LEN && val.str[STR_LEN] != '\0');
                 }
-                if (c == '\0') { break; }
-                str[pos++] = c;
+                pos += length;
+            }
+        }
+    }
+
+
+
+    template<FormatSpec spec, typename T>
+        requires string_format<spec> && (utils::is_char_array_holder<T> || utils::is_dyn_str_holder<T>)
+    constexpr size_t exact_str_length(const T& val)
+    {
+        constexpr size_t STR_LEN = T::size();
+        if constexpr (STR_LEN == 0) {
+            return 0;
+        }
+        else if constexpr (utils::is_char_array_holder<T>) {
+            return std::find(T::get(), T::get() + STR_LEN, '\0') - T::get();
+        }
+        else if (std::is_constant_evaluated()) {
+            size_t length = 0;
+            while (length < STR_LEN && val.str[length] != '\0') {
+                length++;
             }
+            return length;
+        }
+        else {
+            return utils::bounded_str_length<STR_LEN>(val.str);
         }
     }
     
@@ -592,17 +2578,17 @@ namespace cst_fmt::specialisation
     // string_view
     
     
-    template<char fmt, typename T>
-    	requires string_format<fmt> && utils::is_str_view_holder<T>
+    template<FormatSpec spec, typename T>
+    	requires string_format<spec> && utils::is_str_view_holder<T>
     consteval size_t formatted_str_length()
     {
     	return T::get().size();
     }
     
     
-    template<char fmt, size_t N, typename T>
-    	requires string_format<fmt> && utils::is_str_view_holder<T>
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+    template<FormatSpec spec, typename Str, typename T>
+    	requires string_format<spec> && utils::is_str_view_holder<T>
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
     {
     	constexpr size_t STR_LEN = T::get().size();
     	for (size_t i = 0; i < STR_LEN; i++) {
@@ -610,199 +2596,641 @@ namespace cst_fmt::specialisation
     	}
     	pos += STR_LEN;
     }
+
+
+
+    template<FormatSpec spec, typename T>
+        requires string_format<spec> && utils::is_str_view_holder<T>
+    constexpr size_t exact_str_length(const T&)
+    {
+        return T::get().size();
+    }
+    
+    
+    // string_view with a maximum length
+
+
+    template<FormatSpec spec, typename T>
+        requires string_format<spec> && utils::is_dyn_str_view_holder<T>
+    consteval size_t formatted_str_length()
+    {
+        return T::size();
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires string_format<spec> && utils::is_dyn_str_view_holder<T>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        // The size is known: no need to look for a '\0', which is copied like any other character
+        const size_t length = val.str.size() < T::size() ? val.str.size() : T::size();
+        if (std::is_constant_evaluated()) {
+            for (size_t i = 0; i < length; i++) {
+                str[pos + i] = val.str[i];
+            }
+        }
+        else if (length > 0) {
+            std::memcpy(&str[pos], val.str.data(), length);
+        }
+
+        if constexpr (T::truncation() != Truncation::silent) {
+            utils::apply_truncation<T::truncation(), T::size()>(str, pos, val.str.size() > T::size());
+        }
+        pos += length;
+    }
+
+
+
+    template<FormatSpec spec, typename T>
+        requires string_format<spec> && utils::is_dyn_str_view_holder<T>
+    constexpr size_t exact_str_length(const T& val)
+    {
+        return val.str.size() < T::size() ? val.str.size() : T::size();
+    }
     
     
     // Wrong string argument
     
     
-    template<char fmt, typename T>
-    	requires string_format<fmt>
+    template<FormatSpec spec, typename T>
+    	requires string_format<spec>
                  && (!utils::is_char_array_holder<T>)
                  && (!utils::is_str_view_holder<T>)
                  && (!utils::is_dyn_str_holder<T>)
+                 && (!utils::is_dyn_str_view_holder<T>)
+    consteval size_t formatted_str_length()
+    {
+        static_assert(spec.type == '\0', "'%s' expected a string view (or char array) holder");
+        return 0;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires string_format<spec>
+             && (!utils::is_char_array_holder<T>)
+             && (!utils::is_str_view_holder<T>)
+             && (!utils::is_dyn_str_holder<T>)
+             && (!utils::is_dyn_str_view_holder<T>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
+    {
+        static_assert(spec.type == '\0', "'%s' expected a string view (or char array) holder");
+    }
+
+
+    //
+    // %c -> character
+    //
+
+
+    template<FormatSpec spec>
+    concept char_format = spec.type == 'c';
+
+
+    template<FormatSpec spec, typename T>
+        requires char_format<spec> && std::same_as<std::remove_cv_t<T>, char>
+    consteval size_t formatted_str_length()
+    {
+        return 1;
+    }
+
+
+    template<FormatSpec spec, typename T>
+        requires char_format<spec> && (!std::same_as<std::remove_cv_t<T>, char>)
     consteval size_t formatted_str_length()
     {
-        static_assert(fmt == '\0', "'%s' expected a string view (or char array) holder");
+        static_assert(spec.type == '\0', "'%c' expected a char type");
+        return 0;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires char_format<spec> && std::same_as<std::remove_cv_t<T>, char>
+    constexpr void format_to_str(Str& str, size_t& pos, const T& val)
+    {
+        str[pos++] = val;
+    }
+
+
+
+    template<FormatSpec spec, typename T>
+        requires char_format<spec> && std::same_as<std::remove_cv_t<T>, char>
+    constexpr size_t exact_str_length(const T&)
+    {
+        return 1;
+    }
+
+
+    template<FormatSpec spec, typename Str, typename T>
+        requires char_format<spec> && (!std::same_as<std::remove_cv_t<T>, char>)
+    constexpr void format_to_str(Str& str, size_t& pos, const T&)
+    {
+        static_assert(spec.type == '\0', "'%c' expected a char type");
+    }
+
+    
+    /**
+     * Fallback option, used only when the format type is not specified by another definition.
+     * Made to fail in all cases.
+     */
+    template<FormatSpec spec, typename, typename... Args>
+    [[maybe_unused]]
+    consteval size_t formatted_str_length(const Args&...)
+    {
+        static_assert(spec.type == '\0', "Unknown format specifier");
+        static_assert(spec.type != '\0', "'\\0' is not a valid format specifier");
         return 0;
     }
 
+    
+    /**
+     * Fallback option, used only when the format type is not specified by another definition.
+     * Made to fail in all cases.
+     */
+    template<FormatSpec spec>
+    [[maybe_unused]]
+    constexpr void format_to_str(...)
+    {
+        static_assert(spec.type == '\0', "Unknown format specifier");
+        static_assert(spec.type != '\0', "'\\0' is not a valid format specifier");
+    }
+}
+
+
+namespace cst_fmt::internal
+{
+    /**
+     * True if the character after the quote at 'pos' is not alphanumeric, and therefore the separator of the groups of
+     * digits: '%'_d'.
+     */
+    constexpr bool has_custom_separator(std::string_view fmt_str, size_t pos)
+    {
+        if (pos + 1 >= fmt_str.size()) {
+            return false;
+        }
+        const char c = fmt_str[pos + 1];
+        return !(('0' <= c && c <= '9') || ('a' <= c && c <= 'z') || ('A' <= c && c <= 'Z'));
+    }
+
+
+    /**
+     * Returns the position after the alignment and grouping flags and the width of the format specifier starting at
+     * 'pos'.
+     */
+    constexpr size_t find_format_width_end(std::string_view fmt_str, size_t pos)
+    {
+        size_t i = pos;
+        if (i < fmt_str.size() && fmt_str[i] == '-') {
+            i++;
+        }
+        if (i < fmt_str.size() && fmt_str[i] == '\'') {
+            i += 1 + has_custom_separator(fmt_str, i);
+        }
+        while (i < fmt_str.size() && '0' <= fmt_str[i] && fmt_str[i] <= '9') {
+            i++;
+        }
+        return i;
+    }
+
+
+    /**
+     * Returns the position of the type character of the format specifier starting at 'pos', just after the '%'.
+     */
+    constexpr size_t find_format_type(std::string_view fmt_str, size_t pos)
+    {
+        size_t i = find_format_width_end(fmt_str, pos);
+        if (i < fmt_str.size() && fmt_str[i] == '.') {
+            do {
+                i++;
+            } while (i < fmt_str.size() && '0' <= fmt_str[i] && fmt_str[i] <= '9');
+        }
+        return i;
+    }
+
+
+    /**
+     * Returns the number of format specifiers in the format string.
+     */
+    constexpr size_t count_format_specs(std::string_view fmt_str)
+    {
+        size_t count = 0;
+        for (size_t i = 0; i < fmt_str.size(); i++) {
+            if (fmt_str[i] == '%') {
+                i = find_format_type(fmt_str, i + 1);
+                count++;
+            }
+        }
+        return count;
+    }
+
+
+    enum class FormatError
+    {
+        none,
+        missing_type,
+        missing_precision,
+        unsupported_precision,
+        unsupported_grouping
+    };
+
+
+    /**
+     * Parses the format specifier starting at 'pos', just after the '%': '%[-]['[separator]][width][.precision]type'.
+     */
+    constexpr FormatSpec parse_format_spec(std::string_view fmt_str, size_t pos, FormatError& error)
+    {
+        const size_t width_end = find_format_width_end(fmt_str, pos);
+        const size_t type_pos = find_format_type(fmt_str, pos);
+        if (type_pos >= fmt_str.size()) {
+            error = FormatError::missing_type;
+            return {};
+        }
+
+        FormatSpec spec{ fmt_str[type_pos] };
+
+        // Without a width, the alignment is only used by fixed layouts
+        spec.left_align = fmt_str[pos] == '-';
+
+        size_t width_start = pos + spec.left_align;
+        if (fmt_str[width_start] == '\'') {
+            const bool custom_separator = has_custom_separator(fmt_str, width_start);
+            spec.separator = custom_separator ? fmt_str[width_start + 1] : ',';
+            width_start += 1 + custom_separator;
+            if (spec.type != 'd') {
+                error = FormatError::unsupported_grouping;
+            }
+        }
+
+        for (size_t i = width_start; i < width_end; i++) {
+            spec.width = spec.width * 10 + (fmt_str[i] - '0');
+        }
+
+        if (fmt_str[width_end] == '.') {
+            if (type_pos == width_end + 1) {
+                error = FormatError::missing_precision;
+            }
+            else if (spec.type != 'f' && spec.type != 'e') {
+                error = FormatError::unsupported_precision;
+            }
+
+            spec.precision = 0;
+            for (size_t i = width_end + 1; i < type_pos; i++) {
+                spec.precision = spec.precision * 10 + (fmt_str[i] - '0');
+            }
+        }
+
+        return spec;
+    }
+
+
+    /**
+     * The characters of the format string before an argument, and the format specifier of the argument.
+     * The last segment of a format has no argument: its type is '\0'.
+     */
+    struct FormatSegment
+    {
+        // Position and length of the characters in the literal image
+        size_t literal_offset;
+        size_t literal_length;
+        FormatSpec spec;
+    };
+
+
+    template<size_t S>
+    struct ParsedFormat
+    {
+        std::array<FormatSegment, S> segments{};
+        FormatError error = FormatError::none;
+
+        [[nodiscard]]
+        static constexpr size_t args_count() { return S - 1; }
+    };
+
 
-    template<char fmt, size_t N, typename T>
-        requires string_format<fmt>
-             && (!utils::is_char_array_holder<T>)
-             && (!utils::is_str_view_holder<T>)
-             && (!utils::is_dyn_str_holder<T>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+    /**
+     * Splits the format string into segments, all at once. Parsing stops at the first error.
+     */
+    template<const std::string_view& fmt>
+    consteval auto parse_format()
     {
-        static_assert(fmt == '\0', "'%s' expected a string view (or char array) holder");
-    }
+        ParsedFormat<count_format_specs(fmt) + 1> parsed{};
+
+        size_t segment = 0;
+        size_t literal_offset = 0;
+        size_t literal_start = 0;
+        for (size_t i = 0; i < fmt.size(); i++) {
+            if (fmt[i] != '%') {
+                continue;
+            }
 
+            FormatSegment& current = parsed.segments[segment++];
+            current.literal_offset = literal_offset;
+            current.literal_length = i - literal_start;
+            literal_offset += current.literal_length;
 
-    //
-    // %c -> character
-    //
+            current.spec = parse_format_spec(fmt, i + 1, parsed.error);
+            if (parsed.error != FormatError::none) {
+                return parsed;
+            }
 
+            i = find_format_type(fmt, i + 1);
+            literal_start = i + 1;
+        }
 
-    template<char fmt>
-    concept char_format = fmt == 'c';
+        FormatSegment& last = parsed.segments[segment];
+        last.literal_offset = literal_offset;
+        last.literal_length = fmt.size() - literal_start;
+        return parsed;
+    }
 
 
-    template<char fmt, typename T>
-        requires char_format<fmt> && std::same_as<std::remove_cv_t<T>, char>
-    consteval size_t formatted_str_length()
-    {
-        return 1;
-    }
+    template<const std::string_view& fmt>
+    inline constexpr auto parsed_format = parse_format<fmt>();
 
 
-    template<char fmt, typename T>
-        requires char_format<fmt> && (!std::same_as<std::remove_cv_t<T>, char>)
-    consteval size_t formatted_str_length()
-    {
-        static_assert(fmt == '\0', "'%c' expected a char type");
-        return 0;
-    }
+    /**
+     * All characters of the format string outside of the format specifiers, copied to the result of each call.
+     */
+    template<const std::string_view& fmt>
+    inline constexpr auto literal_image = [] {
+        constexpr auto& last = parsed_format<fmt>.segments.back();
+        std::array<char, last.literal_offset + last.literal_length> image{};
+        size_t pos = 0;
+        // The image stops at the first error of the format
+        for (size_t i = 0; i < fmt.size() && pos < image.size(); i++) {
+            if (fmt[i] == '%') {
+                i = find_format_type(fmt, i + 1);
+            }
+            else {
+                image[pos++] = fmt[i];
+            }
+        }
+        return image;
+    }();
 
 
-    template<char fmt, size_t N, typename T>
-        requires char_format<fmt> && std::same_as<std::remove_cv_t<T>, char>
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T& val)
+    /**
+     * Reports errors in the format string, or a mismatch with the number of arguments. Returns true if there is none.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    consteval bool check_format()
     {
-        str[pos++] = val;
+        constexpr auto& parsed = parsed_format<fmt>;
+        static_assert(parsed.error != FormatError::missing_type, "Missing format type after '%'");
+        static_assert(parsed.error != FormatError::missing_precision, "Missing precision after '.'");
+        static_assert(parsed.error != FormatError::unsupported_precision,
+                      "Precision is only supported by '%f' and '%e'");
+        static_assert(parsed.error != FormatError::unsupported_grouping, "Digit grouping is only supported by '%d'");
+        static_assert(parsed.args_count() <= sizeof...(Args), "Too many arguments for format string");
+        static_assert(parsed.args_count() >= sizeof...(Args), "Not enough arguments for format string");
+        return parsed.error == FormatError::none && parsed.args_count() == sizeof...(Args);
     }
 
 
-    template<char fmt, size_t N, typename T>
-        requires char_format<fmt> && (!std::same_as<std::remove_cv_t<T>, char>)
-    constexpr void format_to_str(std::array<char, N>& str, size_t& pos, const T&)
+    /**
+     * Maximum length of a formatted argument, including its padding.
+     */
+    template<FormatSpec spec, typename T>
+    consteval size_t field_max_width()
     {
-        static_assert(fmt == '\0', "'%c' expected a char type");
+        constexpr size_t value_width = specialisation::formatted_str_length<spec, T>();
+        return value_width > size_t(spec.width) ? value_width : size_t(spec.width);
     }
 
-    
+
     /**
-     * Fallback option, used only when 'fmt' is not specified by another definition.
-     * Made to fail in all cases.
+     * The position of each argument in the literals of the format string, and its maximum length.
      */
-    template<char fmt, typename, typename... Args>
-    [[maybe_unused]]
-    consteval size_t formatted_str_length(const Args&...)
-    {
-        static_assert(fmt == '\0', "Unknown format specifier");
-        static_assert(fmt != '\0', "'\\0' is not a valid format specifier");
-        return 0;
-    }
+    template<const std::string_view& fmt, typename... Args>
+    inline constexpr auto format_holes = []<size_t... I>(std::index_sequence<I...>) {
+        constexpr auto& segments = parsed_format<fmt>.segments;
+        return std::array<FormatHole, sizeof...(Args)>{
+            FormatHole{
+                segments[I].literal_offset + segments[I].literal_length,
+                field_max_width<segments[I].spec, std::remove_reference_t<Args>>(),
+                segments[I].spec
+            }...
+        };
+    }(std::index_sequence_for<Args...>{});
+
 
-    
     /**
-     * Fallback option, used only when 'fmt' is not specified by another definition.
-     * Made to fail in all cases.
+     * Maximum length of the formatted string, including the final '\0'.
      */
-    template<char fmt>
-    [[maybe_unused]]
-    constexpr void format_to_str(...)
+    template<const std::string_view& fmt, typename... Args>
+    consteval size_t get_formatted_str_length_start()
     {
-        static_assert(fmt == '\0', "Unknown format specifier");
-        static_assert(fmt != '\0', "'\\0' is not a valid format specifier");
+        if constexpr (check_format<fmt, Args...>()) {
+            size_t length = literal_image<fmt>.size() + 1;
+            for (const FormatHole& hole : format_holes<fmt, Args...>) {
+                length += hole.max_width;
+            }
+            return length;
+        }
+        else {
+            return 0;
+        }
     }
-}
 
 
-namespace cst_fmt::internal
-{
-    template<const std::string_view& fmt_str, size_t pos>
-    consteval size_t next_format()
-    {
-        constexpr size_t i = fmt_str.find('%', pos);
-        if constexpr (i == std::string_view::npos) {
-            return std::string_view::npos;
+    /**
+     * All characters of the result of a fixed layout format, with spaces in place of the arguments.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    inline constexpr auto fixed_layout_image = [] {
+        constexpr auto& literals = literal_image<fmt>;
+        constexpr auto& holes = format_holes<fmt, Args...>;
+
+        std::array<char, get_formatted_str_length_start<fmt, Args...>() - 1> image{};
+        size_t pos = 0;
+        size_t literal_pos = 0;
+        for (const FormatHole& hole : holes) {
+            while (literal_pos < hole.literal_offset) {
+                image[pos++] = literals[literal_pos++];
+            }
+            for (size_t i = 0; i < hole.max_width; i++) {
+                image[pos++] = ' ';
+            }
+        }
+        while (literal_pos < literals.size()) {
+            image[pos++] = literals[literal_pos++];
         }
+        return image;
+    }();
 
-        // Check if there is a character after the '%'
-        static_assert(i + 1 < fmt_str.size(), "Missing character after '%'");
 
-        return i + 1;
+    /**
+     * Position of the argument 'i' in the result of a fixed layout format.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    consteval size_t fixed_layout_offset(size_t i)
+    {
+        constexpr auto& holes = format_holes<fmt, Args...>;
+        size_t offset = holes[i].literal_offset;
+        for (size_t j = 0; j < i; j++) {
+            offset += holes[j].max_width;
+        }
+        return offset;
     }
 
 
-    template<const std::string_view& fmt, size_t pos>
-    consteval size_t get_formatted_str_length()
+    /**
+     * Formats the value, padded with spaces to at least 'width' characters, on the left unless 'spec.left_align'.
+     */
+    template<FormatSpec spec, size_t width, typename Str, typename T>
+    constexpr void write_padded_field(Str& str, size_t& str_pos, const T& val)
     {
-        [[maybe_unused]]
-        constexpr size_t nxt = next_format<fmt, pos>();
-        static_assert(nxt == std::string_view::npos, "Not enough arguments for format string");
-        return fmt.size() - pos;
+        if constexpr (spec.left_align) {
+            const size_t start = str_pos;
+            specialisation::format_to_str<spec>(str, str_pos, val);
+            while (str_pos < start + width) {
+                str[str_pos++] = ' ';
+            }
+        }
+        else {
+            // The length of the value is needed before writing it
+            FormattedCharArray<specialisation::formatted_str_length<spec, T>()> field;
+            utils::init_buffer(field);
+            size_t length = 0;
+            specialisation::format_to_str<spec>(field, length, val);
+            if (field.is_truncated()) {
+                utils::report_truncation(str);
+            }
+            for (size_t i = length; i < width; i++) {
+                str[str_pos++] = ' ';
+            }
+            for (size_t i = 0; i < length; i++) {
+                str[str_pos++] = field[i];
+            }
+        }
     }
 
 
-    template<const std::string_view& fmt, size_t pos, typename T, typename... Args>
-    consteval size_t get_formatted_str_length()
+    template<FormatSpec spec, typename Str, typename T>
+    constexpr void write_field(Str& str, size_t& str_pos, const T& val)
     {
-        constexpr size_t nxt = next_format<fmt, pos>();
-        static_assert(nxt != std::string_view::npos, "Too many arguments for format string");
-
-        return nxt - pos - 1 // Characters of the format string from the previous format to the next one, excluding the '%'
-               + specialisation::formatted_str_length<fmt[nxt], std::remove_reference_t<T>>() // Maximum length of the formatted type
-               + get_formatted_str_length<fmt, nxt + 1, Args...>();
+        if constexpr (spec.width > 0) {
+            write_padded_field<spec, spec.width>(str, str_pos, val);
+        }
+        else {
+            specialisation::format_to_str<spec>(str, str_pos, val);
+        }
     }
 
 
-    template<const std::string_view& fmt, typename... Args>
-    consteval size_t get_formatted_str_length_start()
+    /**
+     * Length of the field of the value, as written by 'write_field'.
+     */
+    template<FormatSpec spec, typename T>
+    constexpr size_t field_length(const T& val)
     {
-        if constexpr (fmt.empty()) {
-            static_assert(sizeof...(Args) == 0, "Expected no arguments for empty format string");
-            return 1;
+        size_t length = 0;
+        if constexpr (requires { specialisation::exact_str_length<spec>(val); }) {
+            length = specialisation::exact_str_length<spec>(val);
         }
         else {
-            constexpr size_t nxt = next_format<fmt, 0>();
+            FormattedCharArray<specialisation::formatted_str_length<spec, T>()> field;
+            utils::init_buffer(field);
+            specialisation::format_to_str<spec>(field, length, val);
+        }
+        return length < size_t(spec.width) ? size_t(spec.width) : length;
+    }
 
-            // We add one for the extra '\0' character
 
-            if constexpr (nxt == std::string_view::npos) {
-                static_assert(sizeof...(Args) == 0, "No arguments expected for format string");
-                return fmt.size() + 1;
+    /**
+     * Copies 'length' characters of the literal image, starting at 'offset'.
+     */
+    template<const std::string_view& fmt, size_t offset, size_t length, typename Str>
+    constexpr void copy_literals(Str& str, size_t& str_pos)
+    {
+        if constexpr (length > 0) {
+            constexpr auto& literals = literal_image<fmt>;
+            if (std::is_constant_evaluated()) {
+                for (size_t i = 0; i < length; i++) {
+                    str[str_pos + i] = literals[offset + i];
+                }
             }
             else {
-                static_assert(sizeof...(Args) > 0, "Not enough arguments for format string");
-                return get_formatted_str_length<fmt, 0, Args...>() + 1;
+                // A single copy of a constant size, which compilers inline
+                std::memcpy(&str[str_pos], literals.data() + offset, length);
             }
         }
+        str_pos += length;
     }
 
 
-    template<const std::string_view& fmt, size_t N, size_t start, size_t end>
-    constexpr void copy_fmt_to_array(std::array<char, N>& str, size_t& str_pos)
+    /**
+     * Formats all arguments, each preceded by the literal characters before it.
+     */
+    template<const std::string_view& fmt, typename Str, typename... Args>
+    constexpr void format_internal(Str& str, size_t& str_pos, const Args&... args)
     {
-        constexpr size_t length = end - start;
-        static_assert(length >= 0, "Fatal formatting error");
-        for (size_t i = 0; i < length; i++) {
-            str[str_pos + i] = fmt[start + i];
+        constexpr auto& parsed = parsed_format<fmt>;
+        constexpr auto& segments = parsed.segments;
+
+        // Invalid formats are reported by 'check_format'
+        if constexpr (parsed.error == FormatError::none && parsed.args_count() == sizeof...(Args)) {
+            [&]<size_t... I>(std::index_sequence<I...>) {
+                ((copy_literals<fmt, segments[I].literal_offset, segments[I].literal_length>(str, str_pos),
+                  write_field<segments[I].spec>(str, str_pos, args)), ...);
+            }(std::index_sequence_for<Args...>{});
+
+            constexpr FormatSegment last = segments.back();
+            copy_literals<fmt, last.literal_offset, last.literal_length>(str, str_pos);
         }
-        str_pos += length;
     }
 
 
-    template<const std::string_view& fmt, size_t N, size_t pos = 0>
-    constexpr void parse_format_internal(std::array<char, N>& str, size_t& str_pos)
+    /**
+     * Length of the result of 'format_internal', without writing it.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    constexpr size_t formatted_length(const Args&... args)
     {
-        // Copy the rest of the characters of the format string
-        copy_fmt_to_array<fmt, N, pos, fmt.size()>(str, str_pos);
+        constexpr auto& parsed = parsed_format<fmt>;
+        constexpr auto& segments = parsed.segments;
+
+        if constexpr (parsed.error == FormatError::none && parsed.args_count() == sizeof...(Args)) {
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                return literal_image<fmt>.size() + (size_t(0) + ... + field_length<segments[I].spec>(args));
+            }(std::index_sequence_for<Args...>{});
+        }
+        else {
+            return 0;
+        }
     }
 
 
-    template<const std::string_view& fmt, size_t N, size_t pos = 0, typename T, typename... Args>
-    constexpr void parse_format_internal(std::array<char, N>& str, size_t& str_pos, const T& val, Args&&... args)
+    /**
+     * Formats all arguments at constant positions: the literals are copied in a single block, then each argument is
+     * written in its field, padded to its maximum length.
+     */
+    template<const std::string_view& fmt, typename... FmtArgs, typename Str, typename... Args>
+    constexpr size_t format_fixed_layout(Str& str, const Args&... args)
     {
-        constexpr size_t nxt = next_format<fmt, pos>();
+        static_assert(sizeof...(FmtArgs) == sizeof...(Args), "Wrong number of arguments for the compiled format");
 
-        // Copy the characters between two format positions to the string, excluding the '%'
-        copy_fmt_to_array<fmt, N, pos, nxt - 1>(str, str_pos);
+        constexpr auto& image = fixed_layout_image<fmt, FmtArgs...>;
+        constexpr auto& holes = format_holes<fmt, FmtArgs...>;
+
+        if constexpr (image.size() > 0) {
+            if (std::is_constant_evaluated()) {
+                for (size_t i = 0; i < image.size(); i++) {
+                    str[i] = image[i];
+                }
+            }
+            else {
+                std::memcpy(&str[0], image.data(), image.size());
+            }
+        }
 
-        // Format the value
-        specialisation::format_to_str<fmt[nxt]>(str, str_pos, val);
+        [&]<size_t... I>(std::index_sequence<I...>) {
+            ([&] {
+                size_t pos = fixed_layout_offset<fmt, FmtArgs...>(I);
+                write_padded_field<holes[I].spec, holes[I].max_width>(str, pos, args);
+            }(), ...);
+        }(std::index_sequence_for<Args...>{});
 
-        parse_format_internal<fmt, N, nxt + 1>(str, str_pos, std::forward<Args>(args)...);
+        return image.size();
     }
 }
 
@@ -820,10 +3248,21 @@ namespace cst_fmt
 	/**
 	 * Non-const string with static fixed size reference holder.
 	 * Up to N characters will be copied to the resulting string.
-	 * The copy will stop before the first '\0' character encountered.
+	 * The copy will stop before the first '\0' character encountered, found with a vectorised scan at runtime, which
+	 * reads all N characters: they must be readable, even past the '\0'.
+	 * With a truncation policy other than 'silent', a string of N characters or more must still be terminated.
+	 */
+	template<size_t N, Truncation policy = Truncation::silent>
+	using cstr = utils::DynStrHolder<N, policy>;
+
+	
+	/**
+	 * String view with a static maximum size holder.
+	 * Up to N characters will be copied to the resulting string, in a single copy: the string is not scanned for a
+	 * '\0', which is copied like any other character.
 	 */
-	template<size_t N>
-	using cstr = utils::DynStrHolder<N>;
+	template<size_t N, Truncation policy = Truncation::silent>
+	using sv = utils::DynStrViewHolder<N, policy>;
 
 	
 	/**
@@ -834,6 +3273,55 @@ namespace cst_fmt
 	using str_ref = utils::StrViewHolder<STR>;
 
 
+    /**
+     * Flag for 'cst_fmt::compile_format', to place all arguments at constant positions in the result.
+     */
+    struct FixedLayout {};
+    inline constexpr FixedLayout fixed_layout{};
+
+
+    /**
+     * A simple struct holding reusable information for a format.
+     */
+    template<const std::string_view& fmt, const size_t N, bool fixed_layout, typename... Args>
+    struct CompiledFormat
+    {
+        [[nodiscard]]
+        static constexpr const std::string_view& get_fmt() { return fmt; }
+
+        [[nodiscard]]
+        static constexpr size_t get_str_size() { return N; }
+
+        /**
+         * If true, each argument is padded to its maximum length, and the result has always the same length.
+         */
+        [[nodiscard]]
+        static constexpr bool is_fixed_layout() { return fixed_layout; }
+
+        /**
+         * Position of the argument 'i' in the result, for fixed layout formats.
+         */
+        [[nodiscard]]
+        static consteval size_t get_field_offset(size_t i)
+        {
+            static_assert(fixed_layout, "Only arguments of fixed layout formats have a constant position");
+            return internal::fixed_layout_offset<fmt, Args...>(i);
+        }
+
+        /**
+         * All characters of the format string outside of the format specifiers.
+         */
+        [[nodiscard]]
+        static constexpr const auto& get_literals() { return internal::literal_image<fmt>; }
+
+        /**
+         * The position of each argument in the literals, with its maximum length.
+         */
+        [[nodiscard]]
+        static constexpr const auto& get_holes() { return internal::format_holes<fmt, Args...>; }
+    };
+
+
     /**
      * Parses the given format string and returns information reusable for calls to 'cst_fmt::format'.
      */
@@ -841,20 +3329,40 @@ namespace cst_fmt
     consteval auto compile_format()
     {
         constexpr size_t str_size = internal::get_formatted_str_length_start<fmt, Args...>();
-        return CompiledFormat<fmt, str_size>{};
+        return CompiledFormat<fmt, str_size, false, Args...>{};
+    }
+
+
+    /**
+     * Same as 'cst_fmt::compile_format', but each argument is padded with spaces to its maximum length, aligned on
+     * the right (or on the left with '%-'), and therefore always at the same position in the result.
+     * The characters of the format are copied at once, and the result can be parsed without scanning.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    consteval auto compile_format(FixedLayout)
+    {
+        constexpr size_t str_size = internal::get_formatted_str_length_start<fmt, Args...>();
+        return CompiledFormat<fmt, str_size, true, Args...>{};
     }
 
 
     /**
      * Formats the given arguments by using the information returned by 'cst_fmt::format'.
      */
-    template<const std::string_view& fmt, size_t str_size, typename... Args>
-    constexpr auto format([[maybe_unused]] CompiledFormat<fmt, str_size> compiled_format, Args&&... args)
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, typename... Args>
+    constexpr auto format([[maybe_unused]] CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                          Args&&... args)
     {
-        FormattedCharArray<str_size> str{};
+        FormattedCharArray<str_size> str;
+        utils::init_buffer(str);
 
         size_t str_pos = 0;
-        internal::parse_format_internal<fmt, str_size, 0>(str, str_pos, std::forward<Args>(args)...);
+        if constexpr (fixed_layout) {
+            str_pos = internal::format_fixed_layout<fmt, FmtArgs...>(str, args...);
+        }
+        else {
+            internal::format_internal<fmt>(str, str_pos, args...);
+        }
         str.set_effective_size(str_pos);
 
         if (str_pos < str_size) {
@@ -865,6 +3373,199 @@ namespace cst_fmt
     }
 
 
+    /**
+     * Exact length of the result of formatting the given arguments, without the '\0'.
+     * Integers and strings are measured directly, other values are formatted to a temporary buffer.
+     * For fixed layout formats, this is always 'compiled_format.get_str_size() - 1'.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, typename... Args>
+    constexpr size_t formatted_size(
+            [[maybe_unused]] CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format, const Args&... args)
+    {
+        if constexpr (fixed_layout) {
+            return internal::fixed_layout_image<fmt, FmtArgs...>.size();
+        }
+        else {
+            return internal::formatted_length<fmt>(args...);
+        }
+    }
+
+
+    /**
+     * Formats the arguments directly into the given buffer, which must have room for at least
+     * 'compiled_format.get_str_size() - 1' characters, or exactly 'cst_fmt::formatted_size' characters for these
+     * arguments. No '\0' is added.
+     * Returns a pointer past the last character written.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, typename... Args>
+    constexpr char* format_to([[maybe_unused]] CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                              char* out, Args&&... args)
+    {
+        size_t str_pos = 0;
+        if constexpr (fixed_layout) {
+            str_pos = internal::format_fixed_layout<fmt, FmtArgs...>(out, args...);
+        }
+        else {
+            internal::format_internal<fmt>(out, str_pos, args...);
+        }
+        return out + str_pos;
+    }
+
+
+    /**
+     * Formats the arguments directly into the given span, which size is checked at compile time. No '\0' is added.
+     * Returns a pointer past the last character written.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, size_t extent,
+             typename... Args>
+    constexpr char* format_to(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                              std::span<char, extent> out, Args&&... args)
+    {
+        static_assert(extent != std::dynamic_extent, "The span must have a static size, use a 'char*' otherwise");
+        static_assert(extent >= str_size - 1, "The span is too small for the format");
+        return format_to(compiled_format, out.data(), std::forward<Args>(args)...);
+    }
+
+
+    /**
+     * Formats the arguments, then copies the result to the output iterator. No '\0' is added.
+     * Returns the iterator past the last character written.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, typename OutputIt,
+             typename... Args>
+        requires std::output_iterator<OutputIt, char> && (!std::same_as<OutputIt, char*>)
+    constexpr OutputIt format_to(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                                 OutputIt out, Args&&... args)
+    {
+        const auto str = format(compiled_format, std::forward<Args>(args)...);
+        return std::copy(str.cbegin(), str.cbegin() + str.effective_size(), out);
+    }
+
+
+    /**
+     * Appends the formatted arguments to the string: it is grown by 'compiled_format.get_str_size() - 1' characters,
+     * the arguments are formatted in place, then it is shrunk to the length of the result.
+     * Returns a view of the appended characters.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs, typename... Args>
+    std::string_view format_append(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                                   std::string& out, Args&&... args)
+    {
+        const size_t start = out.size();
+        size_t length = 0;
+#ifdef __cpp_lib_string_resize_and_overwrite
+        // The new characters are not initialized before being overwritten
+        out.resize_and_overwrite(start + str_size - 1, [&](char* data, size_t) {
+            length = size_t(format_to(compiled_format, data + start, args...) - (data + start));
+            return start + length;
+        });
+#else
+        out.resize(start + str_size - 1);
+        length = size_t(format_to(compiled_format, out.data() + start, args...) - (out.data() + start));
+        out.resize(start + length);
+#endif
+        return std::string_view(out.data() + start, length);
+    }
+
+
+    /**
+     * An allocator which can give back the unused end of its last allocation, like 'cst_fmt::BumpArena'.
+     * 'allocate' returns nullptr when there is not enough space.
+     */
+    template<typename A>
+    concept shrinkable_arena = requires(A& arena, char* ptr, size_t size) {
+        { arena.allocate(size) } -> std::convertible_to<char*>;
+        arena.shrink(ptr, size, size);
+    };
+
+
+    /**
+     * Allocates characters from a buffer by bumping a pointer, which memory is reclaimed all at once with 'reset'.
+     */
+    class BumpArena
+    {
+        char* m_begin;
+        char* m_pos;
+        char* m_end;
+
+    public:
+        constexpr explicit BumpArena(std::span<char> buffer)
+            : m_begin(buffer.data()), m_pos(buffer.data()), m_end(buffer.data() + buffer.size())
+        { }
+
+        [[nodiscard]]
+        constexpr char* allocate(size_t size)
+        {
+            if (size_t(m_end - m_pos) < size) {
+                return nullptr;
+            }
+            char* ptr = m_pos;
+            m_pos += size;
+            return ptr;
+        }
+
+        /**
+         * Reduces an allocation of 'size' characters to its first 'new_size' ones. Only the last allocation can give
+         * back its memory.
+         */
+        constexpr void shrink(char* ptr, size_t size, size_t new_size)
+        {
+            if (ptr + size == m_pos) {
+                m_pos = ptr + new_size;
+            }
+        }
+
+        constexpr void reset() { m_pos = m_begin; }
+
+        [[nodiscard]]
+        constexpr size_t used() const { return size_t(m_pos - m_begin); }
+
+        [[nodiscard]]
+        constexpr size_t capacity() const { return size_t(m_end - m_begin); }
+    };
+
+
+    /**
+     * Formats the arguments in place in 'compiled_format.get_str_size() - 1' characters allocated from the arena, then
+     * gives back the unused ones.
+     * Returns a view of the formatted characters, or an empty view with a null pointer if the arena is full.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs,
+             shrinkable_arena Arena, typename... Args>
+    constexpr std::string_view format_append(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                                             Arena& arena, Args&&... args)
+    {
+        constexpr size_t max_length = str_size - 1;
+        char* start = arena.allocate(max_length);
+        if (start == nullptr) {
+            return {};
+        }
+        const size_t length = size_t(format_to(compiled_format, start, args...) - start);
+        arena.shrink(start, max_length, length);
+        return std::string_view(start, length);
+    }
+
+
+    /**
+     * Formats each record of arguments (a std::tuple, or any tuple-like type) back to back into the given buffer, which
+     * must have room for at least 'records.size() * (compiled_format.get_str_size() - 1)' characters. No '\0' is added.
+     * Returns a pointer past the last character written.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs,
+             std::ranges::input_range Records>
+    constexpr char* format_batch(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                                 const Records& records, char* out)
+    {
+        for (const auto& record : records) {
+            // Everything about the format is constant: all of it is inlined in the loop
+            out = std::apply([&](const auto&... args) {
+                return format_to(compiled_format, out, args...);
+            }, record);
+        }
+        return out;
+    }
+
+
     /**
      * Formats the arguments into a FormattedCharArray, which is a std::array<char, N> which length is determined solely
      * on the format string. This result can be converted to a string_view, string or const char*.
@@ -874,10 +3575,11 @@ namespace cst_fmt
     constexpr auto format(Args&&... args)
     {
         constexpr size_t str_size = internal::get_formatted_str_length_start<fmt, Args...>();
-        FormattedCharArray<str_size> str{};
+        FormattedCharArray<str_size> str;
+        utils::init_buffer(str);
 
         size_t str_pos = 0;
-        internal::parse_format_internal<fmt, str_size, 0>(str, str_pos, std::forward<Args>(args)...);
+        internal::format_internal<fmt>(str, str_pos, args...);
         str.set_effective_size(str_pos);
 
         if (str_pos < str_size) {
@@ -886,6 +3588,45 @@ namespace cst_fmt
 
         return str;
     }
+
+
+    /**
+     * Exact length of the result of 'cst_fmt::format<fmt>' for the given arguments, without the '\0'.
+     */
+    template<const std::string_view& fmt, typename... Args>
+    constexpr size_t formatted_size(const Args&... args)
+    {
+        if constexpr (internal::check_format<fmt, Args...>()) {
+            return internal::formatted_length<fmt>(args...);
+        }
+        else {
+            return 0;
+        }
+    }
+
+
+    /**
+     * Formats constant arguments, passed as template parameters, into a FormattedCharArray sized to fit exactly the
+     * result (and its '\0'), instead of the maximum length of the format.
+     * Useful for constant strings stored in the binary: 'static constexpr auto msg = format_exact<fmt, 42, 3.5>();'
+     */
+    template<const std::string_view& fmt, auto... vals>
+    consteval auto format_exact()
+    {
+        constexpr auto full_str = format<fmt>(vals...);
+        return full_str.template trim<full_str.effective_size() + 1>();
+    }
+
+
+    /**
+     * Copies a constant result to a FormattedCharArray sized to fit exactly its characters (and its '\0'), to store
+     * it without the unused space: 'static constexpr auto msg = shrink<full_msg>();', with 'full_msg' static.
+     */
+    template<const auto& str>
+    consteval auto shrink()
+    {
+        return str.template trim<str.effective_size() + 1>();
+    }
 }
 
 
@@ -0,0 +1,945 @@
+#ifndef CONSTEXPRFORMAT_CONST_FORMAT_LOG_H
+#define CONSTEXPRFORMAT_CONST_FORMAT_LOG_H
+
+
+#include "const_format.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+/*
+ * Deferred formatting logger: the logging thread only copies the arguments of a compiled format into a ring buffer,
+ * and a background thread formats them later into the output file.
+ */
+namespace cst_fmt::log
+{
+    /**
+     * How an argument is kept in a record, until it is formatted. Values are copied as they are.
+     */
+    template<typename T>
+    struct StoredArg
+    {
+        using type = T;
+
+        static constexpr T store(const T& val) { return val; }
+    };
+
+
+    /**
+     * The characters of a dynamic string, which may not exist anymore when the record is formatted.
+     * One more character than the maximum is kept, to preserve the truncation of the original string.
+     */
+    template<size_t N>
+    struct StoredStr
+    {
+        uint32_t size;
+        char chars[N + 1];
+    };
+
+
+    template<size_t N, Truncation policy>
+    struct StoredArg<utils::DynStrHolder<N, policy>>
+    {
+        using type = StoredStr<N>;
+
+        static type store(const utils::DynStrHolder<N, policy>& val)
+        {
+            type stored;
+            size_t length = utils::bounded_str_length<N>(val.str);
+            if constexpr (policy != Truncation::silent) {
+                if (length == N && val.str[N] != '\0') {
+                    length++;
+                }
+            }
+            std::memcpy(stored.chars, val.str, length);
+            stored.size = uint32_t(length);
+            return stored;
+        }
+
+        static utils::DynStrViewHolder<N, policy> load(const type& stored)
+        {
+            return { std::string_view(stored.chars, stored.size) };
+        }
+    };
+
+
+    template<size_t N, Truncation policy>
+    struct StoredArg<utils::DynStrViewHolder<N, policy>>
+    {
+        using type = StoredStr<N>;
+
+        static type store(const utils::DynStrViewHolder<N, policy>& val)
+        {
+            type stored;
+            const size_t length = val.str.size() < N + 1 ? val.str.size() : N + 1;
+            std::memcpy(stored.chars, val.str.data(), length);
+            stored.size = uint32_t(length);
+            return stored;
+        }
+
+        static utils::DynStrViewHolder<N, policy> load(const type& stored)
+        {
+            return { std::string_view(stored.chars, stored.size) };
+        }
+    };
+
+
+    template<typename T>
+    constexpr decltype(auto) load_arg(const typename StoredArg<T>::type& stored)
+    {
+        if constexpr (requires { StoredArg<T>::load(stored); }) {
+            return StoredArg<T>::load(stored);
+        }
+        else {
+            return stored;
+        }
+    }
+
+
+    /**
+     * All records start at a multiple of this alignment.
+     */
+    inline constexpr size_t record_alignment = 16;
+
+
+    /**
+     * Formats the arguments of the record, and writes the result to the file.
+     */
+    using RecordWriter = void (*)(const std::byte* record, std::FILE* file);
+
+
+    struct alignas(record_alignment) RecordHeader
+    {
+        // 'nullptr' if the record is only padding up to the end of the ring buffer
+        RecordWriter write;
+        size_t size;
+    };
+
+
+    /**
+     * The layout of the records of a compiled format: a header followed by the stored arguments.
+     */
+    template<typename Compiled>
+    struct RecordLayout;
+
+
+    template<const std::string_view& fmt, size_t N, bool fixed_layout, typename... Args>
+    struct RecordLayout<CompiledFormat<fmt, N, fixed_layout, Args...>>
+    {
+        using Compiled = CompiledFormat<fmt, N, fixed_layout, Args...>;
+
+        struct Record
+        {
+            RecordHeader header;
+            std::tuple<typename StoredArg<Args>::type...> args;
+        };
+
+        static_assert((std::is_trivially_copyable_v<typename StoredArg<Args>::type> && ...),
+                      "Only trivially copyable arguments can be logged");
+        static_assert(alignof(Record) <= record_alignment, "The arguments are over-aligned");
+
+        static constexpr size_t record_size = (sizeof(Record) + record_alignment - 1) / record_alignment
+                                              * record_alignment;
+
+        template<typename... ArgsT>
+        static void store(std::byte* ptr, const ArgsT&... args)
+        {
+            ::new (ptr) Record{ { &write, record_size }, { StoredArg<Args>::store(Args(args))... } };
+        }
+
+        static void write(const std::byte* ptr, std::FILE* file)
+        {
+            const Record& record = *std::launder(reinterpret_cast<const Record*>(ptr));
+            std::apply([&](const auto&... stored) {
+                const auto str = cst_fmt::format(Compiled{}, load_arg<Args>(stored)...);
+                std::fwrite(str.data(), 1, str.effective_size(), file);
+                std::fputc('\n', file);
+            }, record.args);
+        }
+    };
+
+
+    /**
+     * Lock-free ring buffer of records, with a single producer and a single consumer.
+     * Records are contiguous: one which doesn't fit before the end of the buffer starts again at the beginning.
+     */
+    template<size_t Capacity>
+    class RecordRing
+    {
+        static_assert(std::has_single_bit(Capacity) && Capacity % record_alignment == 0,
+                      "The capacity must be a power of two");
+
+        static constexpr size_t mask = Capacity - 1;
+
+        // Positions only increase, the position in the buffer is 'pos & mask'
+        alignas(64) std::atomic<size_t> m_head{0};
+        size_t m_cached_tail = 0;
+        alignas(64) std::atomic<size_t> m_tail{0};
+        alignas(64) std::atomic<uint64_t> m_dropped{0};
+        alignas(64) std::byte m_buffer[Capacity];
+
+    public:
+        /**
+         * Reserves 'size' bytes and writes a record with 'store'. Returns false if there is not enough space.
+         */
+        template<typename Store>
+        bool try_push(size_t size, Store&& store)
+        {
+            const size_t head = m_head.load(std::memory_order_relaxed);
+            const size_t offset = head & mask;
+            const size_t contiguous = Capacity - offset;
+            const size_t needed = size + (contiguous < size ? contiguous : 0);
+
+            if (head + needed - m_cached_tail > Capacity) {
+                m_cached_tail = m_tail.load(std::memory_order_acquire);
+                if (head + needed - m_cached_tail > Capacity) {
+                    m_dropped.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+            }
+
+            size_t start = head;
+            if (contiguous < size) {
+                ::new (m_buffer + offset) RecordHeader{ nullptr, contiguous };
+                start += contiguous;
+            }
+            store(m_buffer + (start & mask));
+            m_head.store(start + size, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * Writes all available records to the file. Returns the number of records written.
+         */
+        size_t consume(std::FILE* file)
+        {
+            size_t tail = m_tail.load(std::memory_order_relaxed);
+            const size_t head = m_head.load(std::memory_order_acquire);
+            size_t count = 0;
+            while (tail != head) {
+                const std::byte* ptr = m_buffer + (tail & mask);
+                const RecordHeader& header = *std::launder(reinterpret_cast<const RecordHeader*>(ptr));
+                if (header.write != nullptr) {
+                    header.write(ptr, file);
+                    count++;
+                }
+                tail += header.size;
+                m_tail.store(tail, std::memory_order_release);
+            }
+            return count;
+        }
+
+        /**
+         * Number of records lost because the buffer was full.
+         */
+        [[nodiscard]]
+        uint64_t dropped() const { return m_dropped.load(std::memory_order_relaxed); }
+    };
+
+
+    /**
+     * Logs records of compiled formats to a file, formatted by a background thread.
+     * Each thread logging has its own ring buffer of 'RingCapacity' bytes. When it is full, records are dropped.
+     * The rings are kept until the logger is destroyed, which writes the remaining records. A ring is reused by
+     * threads with the same id as a finished one.
+     */
+    template<size_t RingCapacity = (1 << 16)>
+    class Logger
+    {
+        using Ring = RecordRing<RingCapacity>;
+
+        std::FILE* m_file;
+        std::chrono::microseconds m_poll_interval;
+
+        struct ThreadRing
+        {
+            std::thread::id owner;
+            std::unique_ptr<Ring> ring;
+        };
+
+        std::mutex m_rings_mutex;
+        std::vector<ThreadRing> m_rings;
+
+        // The rings read by the background thread, copied from 'm_rings' so that it writes to the file without holding
+        // the lock, which a thread logging for the first time waits for
+        std::vector<Ring*> m_consumed_rings;
+
+        std::atomic<bool> m_running{true};
+        std::thread m_thread;
+
+        // Distinguishes loggers which may be allocated at the same address
+        const uint64_t m_id = next_id();
+
+        static uint64_t next_id()
+        {
+            static std::atomic<uint64_t> id{0};
+            return id.fetch_add(1, std::memory_order_relaxed) + 1;
+        }
+
+        Ring& thread_ring()
+        {
+            // The ring of the last logger used by this thread
+            struct CachedRing
+            {
+                uint64_t logger_id = 0;
+                Ring* ring = nullptr;
+            };
+            thread_local CachedRing cache;
+
+            if (cache.logger_id != m_id) [[unlikely]] {
+                std::lock_guard lock(m_rings_mutex);
+                const auto owner = std::this_thread::get_id();
+                auto it = std::find_if(m_rings.begin(), m_rings.end(), [&](const ThreadRing& ring) {
+                    return ring.owner == owner;
+                });
+                if (it == m_rings.end()) {
+                    it = m_rings.insert(m_rings.end(), { owner, std::make_unique<Ring>() });
+                }
+                cache.logger_id = m_id;
+                cache.ring = it->ring.get();
+            }
+            return *cache.ring;
+        }
+
+        size_t consume_all()
+        {
+            {
+                // Rings are only ever added
+                std::lock_guard lock(m_rings_mutex);
+                for (size_t i = m_consumed_rings.size(); i < m_rings.size(); i++) {
+                    m_consumed_rings.push_back(m_rings[i].ring.get());
+                }
+            }
+            size_t count = 0;
+            for (Ring* ring : m_consumed_rings) {
+                count += ring->consume(m_file);
+            }
+            return count;
+        }
+
+        void run()
+        {
+            while (m_running.load(std::memory_order_acquire)) {
+                if (consume_all() == 0) {
+                    std::fflush(m_file);
+                    std::this_thread::sleep_for(m_poll_interval);
+                }
+            }
+            consume_all();
+            std::fflush(m_file);
+        }
+
+    public:
+        explicit Logger(std::FILE* file, std::chrono::microseconds poll_interval = std::chrono::microseconds(100))
+            : m_file(file), m_poll_interval(poll_interval), m_thread([this] { run(); })
+        { }
+
+        Logger(const Logger&) = delete;
+        Logger& operator=(const Logger&) = delete;
+
+        ~Logger()
+        {
+            m_running.store(false, std::memory_order_release);
+            m_thread.join();
+        }
+
+        /**
+         * Copies the arguments to the ring buffer of the calling thread, converted to the types of the compiled format.
+         * Returns false if the record was dropped because the ring buffer is full.
+         */
+        template<const std::string_view& fmt, size_t N, bool fixed_layout, typename... FmtArgs, typename... Args>
+        bool log(CompiledFormat<fmt, N, fixed_layout, FmtArgs...>, const Args&... args)
+        {
+            static_assert(sizeof...(FmtArgs) == sizeof...(Args), "Wrong number of arguments for the compiled format");
+
+            using Layout = RecordLayout<CompiledFormat<fmt, N, fixed_layout, FmtArgs...>>;
+            static_assert(Layout::record_size <= RingCapacity / 2, "The records of this format are too big");
+
+            return thread_ring().try_push(Layout::record_size, [&](std::byte* ptr) {
+                Layout::store(ptr, args...);
+            });
+        }
+
+        /**
+         * Number of records lost because a ring buffer was full.
+         */
+        [[nodiscard]]
+        uint64_t dropped()
+        {
+            std::lock_guard lock(m_rings_mutex);
+            uint64_t count = 0;
+            for (const ThreadRing& ring : m_rings) {
+                count += ring.ring->dropped();
+            }
+            return count;
+        }
+    };
+}
+
+
+/*
+ * Binary logs: records hold only an identifier of their format and the raw arguments, and are rendered to text offline
+ * with the manifest of the formats of the program.
+ */
+namespace cst_fmt::log
+{
+    /**
+     * 64-bit FNV-1a hash, continued from 'hash'.
+     */
+    constexpr uint64_t fnv1a(std::string_view str, uint64_t hash = 0xCBF29CE484222325ull)
+    {
+        for (char c : str) {
+            hash = (hash ^ uint8_t(c)) * 0x100000001B3ull;
+        }
+        return hash;
+    }
+
+
+    /**
+     * How an argument is stored in a binary record: its kind, the number of bytes of a value, or the maximum length of
+     * a string, and the truncation policy of strings.
+     */
+    struct ArgDescriptor
+    {
+        // 'b': bool, 'c': char, 'i': signed integer, 'u': unsigned integer, 'f': floating point, 's': string
+        char kind;
+        size_t size;
+        Truncation policy = Truncation::silent;
+    };
+
+
+    template<typename T>
+    consteval ArgDescriptor arg_descriptor()
+    {
+        if constexpr (std::same_as<T, bool>) {
+            return { 'b', 1 };
+        }
+        else if constexpr (std::same_as<T, char>) {
+            return { 'c', 1 };
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            return { std::is_signed_v<T> ? 'i' : 'u', sizeof(T) };
+        }
+        else if constexpr (std::is_floating_point_v<T>) {
+            return { 'f', sizeof(T) };
+        }
+        else if constexpr (utils::is_dyn_str_holder<T> || utils::is_dyn_str_view_holder<T>) {
+            return { 's', T::size(), T::truncation() };
+        }
+        else if constexpr (utils::is_char_array_holder<T>) {
+            return { 's', T::size() };
+        }
+        else if constexpr (utils::is_str_view_holder<T>) {
+            return { 's', T::get().size() };
+        }
+        else {
+            static_assert(!std::same_as<T, T>, "This argument type cannot be written to a binary log");
+            return {};
+        }
+    }
+
+
+    /**
+     * The descriptors of the arguments as text, separated by commas: 'i4,f8,s64e'. '-' if there are no arguments.
+     */
+    template<typename... Args>
+    inline constexpr auto format_signature = [] {
+        constexpr std::array<ArgDescriptor, sizeof...(Args)> descriptors{ arg_descriptor<Args>()... };
+
+        // Kind, size, policy and separator for each argument
+        std::array<char, sizeof...(Args) * (1 + std::numeric_limits<size_t>::digits10 + 1 + 1 + 1) + 2> signature{};
+        size_t pos = 0;
+        for (const ArgDescriptor& descriptor : descriptors) {
+            if (pos > 0) {
+                signature[pos++] = ',';
+            }
+            signature[pos++] = descriptor.kind;
+            utils::int_to_char_array(signature, pos, descriptor.size);
+            if (descriptor.policy == Truncation::ellipsis) {
+                signature[pos++] = 'e';
+            }
+            else if (descriptor.policy == Truncation::report) {
+                signature[pos++] = 'r';
+            }
+        }
+        if (pos == 0) {
+            signature[pos++] = '-';
+        }
+        return std::pair{ signature, pos };
+    }();
+
+
+    /**
+     * Everything needed to render the binary records of a format.
+     */
+    struct FormatInfo
+    {
+        uint64_t id;
+        std::string_view fmt;
+        std::string_view signature;
+        size_t max_length;
+    };
+
+
+    template<typename Compiled>
+    struct BinaryRecord;
+
+
+    template<const std::string_view& fmt, size_t N, bool fixed_layout, typename... Args>
+    struct BinaryRecord<CompiledFormat<fmt, N, fixed_layout, Args...>>
+    {
+        static constexpr std::string_view signature{ format_signature<Args...>.first.data(),
+                                                     format_signature<Args...>.second };
+
+        /**
+         * Identifier of the format, which stays the same between builds as long as the format string and the types
+         * of its arguments don't change.
+         */
+        static constexpr uint64_t id = fnv1a(signature, fnv1a(fmt) ^ fixed_layout);
+
+        static constexpr FormatInfo info{ id, fmt, signature, N - 1 };
+
+        // The identifier, the size of the arguments, then the arguments
+        static constexpr size_t header_size = sizeof(uint64_t) + sizeof(uint32_t);
+
+        template<typename T>
+        static consteval size_t arg_max_size()
+        {
+            constexpr ArgDescriptor descriptor = arg_descriptor<T>();
+            if constexpr (descriptor.kind == 's') {
+                return sizeof(uint32_t) + descriptor.size + 1;
+            }
+            else {
+                return descriptor.size;
+            }
+        }
+
+        static constexpr size_t max_size = header_size + (arg_max_size<Args>() + ... + 0);
+    };
+
+
+    /**
+     * All formats which were written to a binary log by this program.
+     */
+    class FormatRegistry
+    {
+        std::mutex m_mutex;
+        std::vector<FormatInfo> m_formats;
+
+    public:
+        static FormatRegistry& instance()
+        {
+            static FormatRegistry registry;
+            return registry;
+        }
+
+        bool add(const FormatInfo& info)
+        {
+            std::lock_guard lock(m_mutex);
+            m_formats.push_back(info);
+            return true;
+        }
+
+        /**
+         * Writes one line per format: its identifier, maximum length, signature, and the format string with '\', '\n'
+         * and '\r' escaped.
+         */
+        void write_manifest(std::FILE* file)
+        {
+            std::lock_guard lock(m_mutex);
+            for (const FormatInfo& info : m_formats) {
+                std::fprintf(file, "%016llx %zu %.*s ", static_cast<unsigned long long>(info.id), info.max_length,
+                             int(info.signature.size()), info.signature.data());
+                for (char c : info.fmt) {
+                    switch (c) {
+                    case '\\': std::fputs("\\\\", file); break;
+                    case '\n': std::fputs("\\n", file); break;
+                    case '\r': std::fputs("\\r", file); break;
+                    default:   std::fputc(c, file); break;
+                    }
+                }
+                std::fputc('\n', file);
+            }
+        }
+    };
+
+
+    /**
+     * Each format is added to the registry during the static initialisation of the program, once for every compiled
+     * format written to a binary log: the manifest can be written at startup.
+     */
+    template<typename Compiled>
+    inline const bool format_registered = FormatRegistry::instance().add(BinaryRecord<Compiled>::info);
+
+
+    /**
+     * Writes records of compiled formats to a binary file, without formatting them.
+     * Integers and floating point numbers are written in the byte order of the program, strings as their length
+     * followed by their characters.
+     */
+    class BinaryWriter
+    {
+        std::FILE* m_file;
+
+        template<typename T>
+        static void write_arg(std::byte*& ptr, const T& val)
+        {
+            if constexpr (utils::is_dyn_str_holder<T> || utils::is_dyn_str_view_holder<T>) {
+                const auto stored = StoredArg<T>::store(val);
+                std::memcpy(ptr, &stored.size, sizeof(stored.size));
+                std::memcpy(ptr + sizeof(stored.size), stored.chars, stored.size);
+                ptr += sizeof(stored.size) + stored.size;
+            }
+            else if constexpr (utils::is_char_array_holder<T> || utils::is_str_view_holder<T>) {
+                const std::string_view str = utils::is_str_view_holder<T>
+                    ? std::string_view(T::get())
+                    : std::string_view(T::get(), std::find(T::get(), T::get() + T::size(), '\0'));
+                const auto size = uint32_t(str.size());
+                std::memcpy(ptr, &size, sizeof(size));
+                std::memcpy(ptr + sizeof(size), str.data(), str.size());
+                ptr += sizeof(size) + str.size();
+            }
+            else {
+                std::memcpy(ptr, &val, sizeof(T));
+                ptr += sizeof(T);
+            }
+        }
+
+    public:
+        explicit BinaryWriter(std::FILE* file) : m_file(file) { }
+
+        /**
+         * Writes the identifier of the format and its arguments, converted to the types of the compiled format.
+         */
+        template<const std::string_view& fmt, size_t N, bool fixed_layout, typename... FmtArgs, typename... Args>
+        void write(CompiledFormat<fmt, N, fixed_layout, FmtArgs...>, const Args&... args)
+        {
+            static_assert(sizeof...(FmtArgs) == sizeof...(Args), "Wrong number of arguments for the compiled format");
+
+            using Compiled = CompiledFormat<fmt, N, fixed_layout, FmtArgs...>;
+            using Record = BinaryRecord<Compiled>;
+            static_cast<void>(format_registered<Compiled>);
+
+            std::byte buffer[Record::max_size];
+            std::byte* ptr = buffer + Record::header_size;
+            (write_arg<FmtArgs>(ptr, FmtArgs(args)), ...);
+
+            const uint64_t id = Record::id;
+            const auto args_size = uint32_t(ptr - buffer - Record::header_size);
+            std::memcpy(buffer, &id, sizeof(id));
+            std::memcpy(buffer + sizeof(id), &args_size, sizeof(args_size));
+            std::fwrite(buffer, 1, ptr - buffer, m_file);
+        }
+    };
+
+
+    //
+    // Offline decoding
+    //
+
+
+    /**
+     * Formats a value with a format specifier known only at runtime, by selecting the specialisation of its type.
+     * Returns false if the specifier doesn't apply to the type.
+     */
+    template<typename T>
+    bool format_runtime_spec(std::string& out, FormatSpec spec, const T& val)
+    {
+        const auto write = [&]<FormatSpec static_spec>() {
+            // Written in place: all specifiers share the same 'char*' sink, instead of arrays of different sizes
+            const size_t start = out.size();
+            out.resize(start + specialisation::formatted_str_length<static_spec, T>());
+            char* field = out.data() + start;
+            size_t length = 0;
+            specialisation::format_to_str<static_spec>(field, length, val);
+            out.resize(start + length);
+            return true;
+        };
+
+        if constexpr (std::is_floating_point_v<T>) {
+            if (spec.type != 'f' && spec.type != 'e') {
+                return false;
+            }
+            const bool scientific = spec.type == 'e';
+            return [&]<int32_t... P>(std::integer_sequence<int32_t, P...>) {
+                // P - 1 is the precision, from -1 (none) to the maximum
+                return ((spec.precision == P - 1
+                         && (scientific ? write.template operator()<FormatSpec{ 'e', P - 1 }>()
+                                        : write.template operator()<FormatSpec{ 'f', P - 1 }>())) || ...);
+            }(std::make_integer_sequence<int32_t, utils::max_float_precision + 2>{});
+        }
+        else if constexpr (std::is_integral_v<T>) {
+            if constexpr (std::same_as<T, char>) {
+                if (spec.type == 'c') {
+                    return write.template operator()<FormatSpec{ 'c' }>();
+                }
+            }
+            constexpr FormatSpec grouped{ 'd', -1, 0, false, ',' };
+            if constexpr (specialisation::formatted_str_length<grouped, T>()
+                          > specialisation::formatted_str_length<FormatSpec{ 'd' }, T>()) {
+                // Only types with groups of digits: others are written as plain '%d'
+                if (spec.type == 'd' && spec.separator != '\0') {
+                    // Grouped with ',', then replaced: the digits never contain it
+                    const size_t start = out.size();
+                    write.template operator()<grouped>();
+                    std::replace(out.begin() + ptrdiff_t(start), out.end(), ',', spec.separator);
+                    return true;
+                }
+            }
+            switch (spec.type) {
+            case 'd': return write.template operator()<FormatSpec{ 'd' }>();
+            case 'x': return write.template operator()<FormatSpec{ 'x' }>();
+            case 'b': return write.template operator()<FormatSpec{ 'b' }>();
+            case 'o': return write.template operator()<FormatSpec{ 'o' }>();
+            default:  return false;
+            }
+        }
+        else {
+            return false;
+        }
+    }
+
+
+    /**
+     * The formats of a program, read from its manifest.
+     */
+    class Manifest
+    {
+        struct Entry
+        {
+            std::string fmt;
+            std::vector<ArgDescriptor> args;
+        };
+
+        std::vector<std::pair<uint64_t, Entry>> m_entries;
+
+        static bool parse_signature(std::string_view signature, std::vector<ArgDescriptor>& args)
+        {
+            if (signature == "-") {
+                return true;
+            }
+            size_t i = 0;
+            while (i < signature.size()) {
+                ArgDescriptor descriptor{ signature[i++], 0 };
+                if (i == signature.size() || signature[i] < '0' || signature[i] > '9') {
+                    return false;
+                }
+                while (i < signature.size() && '0' <= signature[i] && signature[i] <= '9') {
+                    descriptor.size = descriptor.size * 10 + (signature[i++] - '0');
+                }
+                if (i < signature.size() && signature[i] == 'e') {
+                    descriptor.policy = Truncation::ellipsis;
+                    i++;
+                }
+                else if (i < signature.size() && signature[i] == 'r') {
+                    descriptor.policy = Truncation::report;
+                    i++;
+                }
+                if (i < signature.size() && signature[i++] != ',') {
+                    return false;
+                }
+                args.push_back(descriptor);
+            }
+            return true;
+        }
+
+    public:
+        /**
+         * Reads a manifest written by 'FormatRegistry::write_manifest'. Returns false if it is malformed.
+         */
+        bool read(std::FILE* file)
+        {
+            std::string line;
+            int c;
+            while ((c = std::fgetc(file)) != EOF) {
+                if (c != '\n') {
+                    line.push_back(char(c));
+                    continue;
+                }
+
+                // '<id> <max length> <signature> <format>'
+                const size_t id_end = line.find(' ');
+                const size_t length_end = line.find(' ', id_end + 1);
+                const size_t signature_end = line.find(' ', length_end + 1);
+                if (signature_end == std::string::npos) {
+                    return false;
+                }
+
+                const uint64_t id = std::strtoull(line.c_str(), nullptr, 16);
+                Entry entry;
+                if (!parse_signature(std::string_view(line).substr(length_end + 1, signature_end - length_end - 1),
+                                     entry.args)) {
+                    return false;
+                }
+                for (size_t i = signature_end + 1; i < line.size(); i++) {
+                    if (line[i] == '\\' && i + 1 < line.size()) {
+                        const char escaped = line[++i];
+                        entry.fmt.push_back(escaped == 'n' ? '\n' : escaped == 'r' ? '\r' : escaped);
+                    }
+                    else {
+                        entry.fmt.push_back(line[i]);
+                    }
+                }
+                m_entries.emplace_back(id, std::move(entry));
+                line.clear();
+            }
+            return true;
+        }
+
+        /**
+         * Reads the next record of the binary log, and appends its text to 'out'.
+         * Returns false at the end of the file, or if the record cannot be decoded.
+         */
+        bool decode_record(std::FILE* file, std::string& out) const
+        {
+            uint64_t id;
+            uint32_t args_size;
+            if (std::fread(&id, sizeof(id), 1, file) != 1 || std::fread(&args_size, sizeof(args_size), 1, file) != 1) {
+                return false;
+            }
+            std::vector<std::byte> args(args_size);
+            if (args_size > 0 && std::fread(args.data(), args_size, 1, file) != 1) {
+                return false;
+            }
+
+            const auto it = std::find_if(m_entries.begin(), m_entries.end(), [&](const auto& entry) {
+                return entry.first == id;
+            });
+            if (it == m_entries.end()) {
+                return false;
+            }
+            return render(it->second, args, out);
+        }
+
+    private:
+        static bool render(const Entry& entry, const std::vector<std::byte>& args, std::string& out)
+        {
+            const std::string_view fmt = entry.fmt;
+            size_t args_pos = 0;
+            size_t arg = 0;
+            for (size_t i = 0; i < fmt.size(); i++) {
+                if (fmt[i] != '%') {
+                    out.push_back(fmt[i]);
+                    continue;
+                }
+
+                internal::FormatError error = internal::FormatError::none;
+                const FormatSpec spec = internal::parse_format_spec(fmt, i + 1, error);
+                i = internal::find_format_type(fmt, i + 1);
+                if (error != internal::FormatError::none || arg >= entry.args.size()) {
+                    return false;
+                }
+
+                const size_t field_start = out.size();
+                if (!render_arg(entry.args[arg++], spec, args, args_pos, out)) {
+                    return false;
+                }
+                const size_t length = out.size() - field_start;
+                if (length < size_t(spec.width)) {
+                    out.insert(spec.left_align ? out.end() : out.begin() + ptrdiff_t(field_start),
+                               size_t(spec.width) - length, ' ');
+                }
+            }
+            return arg == entry.args.size() && args_pos == args.size();
+        }
+
+        template<typename T>
+        static bool read_value(const std::vector<std::byte>& args, size_t& pos, T& val)
+        {
+            if (pos + sizeof(T) > args.size()) {
+                return false;
+            }
+            std::memcpy(&val, args.data() + pos, sizeof(T));
+            pos += sizeof(T);
+            return true;
+        }
+
+        template<typename T>
+        static bool render_value(FormatSpec spec, const std::vector<std::byte>& args, size_t& pos, std::string& out)
+        {
+            T val;
+            return read_value(args, pos, val) && format_runtime_spec(out, spec, val);
+        }
+
+        static bool render_arg(const ArgDescriptor& descriptor, FormatSpec spec, const std::vector<std::byte>& args,
+                               size_t& pos, std::string& out)
+        {
+            switch (descriptor.kind) {
+            case 'b':
+                return render_value<bool>(spec, args, pos, out);
+
+            case 'c':
+                return render_value<char>(spec, args, pos, out);
+
+            case 'i':
+                switch (descriptor.size) {
+                case 1:  return render_value<int8_t>(spec, args, pos, out);
+                case 2:  return render_value<int16_t>(spec, args, pos, out);
+                case 4:  return render_value<int32_t>(spec, args, pos, out);
+                case 8:  return render_value<int64_t>(spec, args, pos, out);
+#ifdef __SIZEOF_INT128__
+                case 16: return render_value<__int128>(spec, args, pos, out);
+#endif
+                default: return false;
+                }
+
+            case 'u':
+                switch (descriptor.size) {
+                case 1:  return render_value<uint8_t>(spec, args, pos, out);
+                case 2:  return render_value<uint16_t>(spec, args, pos, out);
+                case 4:  return render_value<uint32_t>(spec, args, pos, out);
+                case 8:  return render_value<uint64_t>(spec, args, pos, out);
+#ifdef __SIZEOF_INT128__
+                case 16: return render_value<unsigned __int128>(spec, args, pos, out);
+#endif
+                default: return false;
+                }
+
+            case 'f':
+                // 'long double' may have the same size as 'double'
+                if (descriptor.size == sizeof(float)) {
+                    return render_value<float>(spec, args, pos, out);
+                }
+                else if (descriptor.size == sizeof(double)) {
+                    return render_value<double>(spec, args, pos, out);
+                }
+                else if (descriptor.size == sizeof(long double)) {
+                    return render_value<long double>(spec, args, pos, out);
+                }
+                return false;
+
+            case 's':
+            {
+                uint32_t size;
+                if (spec.type != 's' || !read_value(args, pos, size) || pos + size > args.size()) {
+                    return false;
+                }
+                // The string is kept with one more character than its maximum length, to know if it was truncated
+                const size_t length = size < descriptor.size ? size : descriptor.size;
+                const size_t start = out.size();
+                out.append(reinterpret_cast<const char*>(args.data() + pos), length);
+                pos += size;
+                if (descriptor.policy == Truncation::ellipsis && size > descriptor.size) {
+                    const size_t dots = descriptor.size < 3 ? descriptor.size : 3;
+                    out.replace(start + length - dots, dots, dots, '.');
+                }
+                return true;
+            }
+
+            default:
+                return false;
+            }
+        }
+    };
+}
+
+
+#endif //CONSTEXPRFORMAT_CONST_FORMAT_LOG_H
@@ -0,0 +1,94 @@
+#ifndef CONSTEXPRFORMAT_CONST_FORMAT_PARALLEL_H
+#define CONSTEXPRFORMAT_CONST_FORMAT_PARALLEL_H
+
+
+#include "const_format.h"
+
+#include <barrier>
+#include <memory>
+#include <thread>
+#include <vector>
+
+
+namespace cst_fmt
+{
+    /**
+     * Tag of 'cst_fmt::format_batch' to split the records across threads. 0 threads uses all hardware threads.
+     */
+    struct Parallel
+    {
+        unsigned int threads = 0;
+
+        // Below this count per thread, the records are formatted by the calling thread only
+        size_t min_records_per_thread = 4096;
+    };
+
+    inline constexpr Parallel parallel{};
+
+
+    /**
+     * Same as 'cst_fmt::format_batch', with the records split in contiguous chunks, one per thread. The calling thread
+     * formats the first chunk directly into the buffer, the others format theirs into regions sized for their worst
+     * case. Once all chunks are formatted, their lengths are summed, and each thread copies its region to its final
+     * position in the buffer.
+     */
+    template<const std::string_view& fmt, size_t str_size, bool fixed_layout, typename... FmtArgs,
+             std::ranges::random_access_range Records>
+        requires std::ranges::sized_range<Records>
+    char* format_batch(CompiledFormat<fmt, str_size, fixed_layout, FmtArgs...> compiled_format,
+                       const Records& records, char* out, Parallel options)
+    {
+        constexpr size_t max_length = str_size - 1;
+        const size_t count = std::ranges::size(records);
+
+        size_t threads = options.threads != 0 ? options.threads : std::thread::hardware_concurrency();
+        const size_t min_records = options.min_records_per_thread > 0 ? options.min_records_per_thread : 1;
+        if (count / min_records < threads) {
+            threads = count / min_records;
+        }
+        if (threads <= 1) {
+            return format_batch(compiled_format, records, out);
+        }
+
+        const auto chunk_start = [&](size_t chunk) { return count * chunk / threads; };
+
+        // The first chunk is formatted in place, its region is never used
+        std::unique_ptr<char[]> regions(new char[(count - chunk_start(1)) * max_length]);
+        const auto region = [&](size_t chunk) { return regions.get() + (chunk_start(chunk) - chunk_start(1)) * max_length; };
+
+        std::vector<size_t> offsets(threads + 1, 0);
+        std::barrier sync(ptrdiff_t(threads), [&]() noexcept {
+            // Exclusive prefix sum of the chunk lengths
+            for (size_t chunk = 0; chunk < threads; chunk++) {
+                offsets[chunk + 1] += offsets[chunk];
+            }
+        });
+
+        const auto format_chunk = [&](size_t chunk) {
+            const auto first = std::ranges::begin(records) + ptrdiff_t(chunk_start(chunk));
+            const auto last = std::ranges::begin(records) + ptrdiff_t(chunk_start(chunk + 1));
+            char* start = chunk == 0 ? out : region(chunk);
+            char* end = format_batch(compiled_format, std::ranges::subrange(first, last), start);
+            offsets[chunk + 1] = size_t(end - start);
+
+            sync.arrive_and_wait();
+
+            if (chunk > 0) {
+                std::memcpy(out + offsets[chunk], start, offsets[chunk + 1] - offsets[chunk]);
+            }
+        };
+
+        std::vector<std::jthread> workers;
+        workers.reserve(threads - 1);
+        for (size_t chunk = 1; chunk < threads; chunk++) {
+            workers.emplace_back(format_chunk, chunk);
+        }
+        format_chunk(0);
+        workers.clear();
+
+        return out + offsets[threads];
+    }
+}
+
+
+#endif //CONSTEXPRFORMAT_CONST_FORMAT_PARALLEL_H
@@ -98,3 +98,256 @@ TEST_CASE("bool formats")
         CHECK_EQ(formatted, expected);
     }
 }
+
+
+TEST_CASE("%d integral limits")
+{
+    static constexpr auto fmt_str_d = "%d"sv;
+
+    SUBCASE("8 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_d>(std::numeric_limits<uint8_t>::max());
+        CHECK_EQ(formatted_max, "255"sv);
+        constexpr auto formatted_min = cst_fmt::format<fmt_str_d>(std::numeric_limits<int8_t>::min());
+        CHECK_EQ(formatted_min, "-128"sv);
+    }
+
+    SUBCASE("32 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_d>(std::numeric_limits<uint32_t>::max());
+        CHECK_EQ(formatted_max, "4294967295"sv);
+        constexpr auto formatted_power = cst_fmt::format<fmt_str_d>(uint32_t(1000000000));
+        CHECK_EQ(formatted_power, "1000000000"sv);
+        constexpr auto formatted_below_power = cst_fmt::format<fmt_str_d>(uint32_t(999999999));
+        CHECK_EQ(formatted_below_power, "999999999"sv);
+        constexpr auto formatted_min = cst_fmt::format<fmt_str_d>(std::numeric_limits<int32_t>::min());
+        CHECK_EQ(formatted_min, "-2147483648"sv);
+    }
+
+    SUBCASE("64 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_d>(std::numeric_limits<uint64_t>::max());
+        CHECK_EQ(formatted_max, "18446744073709551615"sv);
+        constexpr auto formatted_signed_max = cst_fmt::format<fmt_str_d>(std::numeric_limits<int64_t>::max());
+        CHECK_EQ(formatted_signed_max, "9223372036854775807"sv);
+        constexpr auto formatted_min = cst_fmt::format<fmt_str_d>(std::numeric_limits<int64_t>::min());
+        CHECK_EQ(formatted_min, "-9223372036854775808"sv);
+        // 2^53 + 1 cannot be represented by a double
+        const uint64_t not_a_double = 9007199254740993ull;
+        const auto formatted_not_a_double = cst_fmt::format<fmt_str_d>(not_a_double);
+        CHECK_EQ(formatted_not_a_double, "9007199254740993"sv);
+    }
+
+#ifdef __SIZEOF_INT128__
+    SUBCASE("128 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_d>(std::numeric_limits<unsigned __int128>::max());
+        CHECK_EQ(formatted_max, "340282366920938463463374607431768211455"sv);
+        constexpr auto formatted_chunk = cst_fmt::format<fmt_str_d>(static_cast<unsigned __int128>(10000000000000000000ull) * 10);
+        CHECK_EQ(formatted_chunk, "100000000000000000000"sv);
+        constexpr auto formatted_signed = cst_fmt::format<fmt_str_d>(-static_cast<__int128>(std::numeric_limits<uint64_t>::max()) - 2);
+        CHECK_EQ(formatted_signed, "-18446744073709551617"sv);
+        constexpr auto formatted_min = cst_fmt::format<fmt_str_d>(std::numeric_limits<__int128>::min());
+        CHECK_EQ(formatted_min, "-170141183460469231731687303715884105728"sv);
+    }
+#endif
+}
+
+
+TEST_CASE("%'d grouped digits")
+{
+    static constexpr auto fmt_str = "%'d"sv;
+    static constexpr auto fmt_str_custom = "%' d|%'_d|%'.d"sv;
+
+    SUBCASE("groups")
+    {
+        constexpr auto small = cst_fmt::format<fmt_str>(999);
+        CHECK_EQ(small, "999"sv);
+        constexpr auto first_group = cst_fmt::format<fmt_str>(1000);
+        CHECK_EQ(first_group, "1,000"sv);
+        constexpr auto negative = cst_fmt::format<fmt_str>(-1234567);
+        CHECK_EQ(negative, "-1,234,567"sv);
+        constexpr auto zero = cst_fmt::format<fmt_str>(0);
+        CHECK_EQ(zero, "0"sv);
+        constexpr auto zeros = cst_fmt::format<fmt_str>(100000001);
+        CHECK_EQ(zeros, "100,000,001"sv);
+        const auto runtime = cst_fmt::format<fmt_str>(int64_t(-12345678901));
+        CHECK_EQ(runtime, "-12,345,678,901"sv);
+    }
+
+    SUBCASE("custom separators")
+    {
+        constexpr auto result = cst_fmt::format<fmt_str_custom>(1234, 5678901, 12);
+        CHECK_EQ(result, "1 234|5_678_901|12"sv);
+    }
+
+    SUBCASE("width")
+    {
+        static constexpr auto fmt_str_width = "[%'8d][%-'8d]"sv;
+        constexpr auto result = cst_fmt::format<fmt_str_width>(12345, 12345);
+        CHECK_EQ(result, "[  12,345][12,345  ]"sv);
+    }
+
+    SUBCASE("limits")
+    {
+        constexpr auto formatted_u8 = cst_fmt::format<fmt_str>(std::numeric_limits<uint8_t>::max());
+        CHECK_EQ(formatted_u8, "255"sv);
+        constexpr auto formatted_i16 = cst_fmt::format<fmt_str>(std::numeric_limits<int16_t>::min());
+        CHECK_EQ(formatted_i16, "-32,768"sv);
+        constexpr auto formatted_u64 = cst_fmt::format<fmt_str>(std::numeric_limits<uint64_t>::max());
+        CHECK_EQ(formatted_u64, "18,446,744,073,709,551,615"sv);
+        CHECK_EQ(formatted_u64.size(), formatted_u64.effective_size() + 1);
+        const auto formatted_i64 = cst_fmt::format<fmt_str>(std::numeric_limits<int64_t>::min());
+        CHECK_EQ(formatted_i64, "-9,223,372,036,854,775,808"sv);
+        CHECK_EQ(formatted_i64.size(), formatted_i64.effective_size() + 1);
+#ifdef __SIZEOF_INT128__
+        constexpr auto formatted_i128 = cst_fmt::format<fmt_str>(std::numeric_limits<__int128>::min());
+        CHECK_EQ(formatted_i128, "-170,141,183,460,469,231,731,687,303,715,884,105,728"sv);
+        CHECK_EQ(formatted_i128.size(), formatted_i128.effective_size() + 1);
+#endif
+    }
+
+    SUBCASE("all lengths")
+    {
+        static constexpr auto fmt_str_sized = "%'d;"sv;
+        constexpr auto fmt = cst_fmt::compile_format<fmt_str_sized, int64_t>();
+        const auto grouped = [](int64_t val) {
+            const std::string digits = std::to_string(val);
+            std::string result;
+            for (size_t i = 0; i < digits.size(); i++) {
+                if (i > 0 && (digits.size() - i) % 3 == 0) {
+                    result += ',';
+                }
+                result += digits[i];
+            }
+            return result;
+        };
+
+        int64_t val = 7;
+        for (int i = 0; i < 18; i++) {
+            CAPTURE(val);
+            const auto result = cst_fmt::format(fmt, val);
+            CHECK_EQ(result, grouped(val) + ";");
+            CHECK_EQ(cst_fmt::formatted_size(fmt, val), result.effective_size());
+            CHECK_EQ(cst_fmt::format(fmt, -val), std::string("-").append(grouped(val)) + ";");
+            val = val * 10 + 7;
+        }
+    }
+}
+
+
+TEST_CASE("%x integral limits")
+{
+    static constexpr auto fmt_str_x = "%x"sv;
+
+    SUBCASE("8 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_x>(std::numeric_limits<uint8_t>::max());
+        CHECK_EQ(formatted_max, "0xFF"sv);
+        const int8_t min = std::numeric_limits<int8_t>::min();
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(min), "0x80"sv);
+    }
+
+    SUBCASE("64 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_x>(std::numeric_limits<uint64_t>::max());
+        CHECK_EQ(formatted_max, "0xFFFFFFFFFFFFFFFF"sv);
+        const uint64_t max = std::numeric_limits<uint64_t>::max();
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(max), "0xFFFFFFFFFFFFFFFF"sv);
+
+        constexpr auto formatted_digits = cst_fmt::format<fmt_str_x>(0x0123456789ABCDEFull);
+        CHECK_EQ(formatted_digits, "0x123456789ABCDEF"sv);
+        const uint64_t digits = 0xFEDCBA9876543210ull;
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(digits), "0xFEDCBA9876543210"sv);
+
+        const int64_t min = std::numeric_limits<int64_t>::min();
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(min), "0x8000000000000000"sv);
+        const int64_t zero = 0;
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(zero), "0x0"sv);
+    }
+
+#ifdef __SIZEOF_INT128__
+    SUBCASE("128 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_x>(std::numeric_limits<unsigned __int128>::max());
+        CHECK_EQ(formatted_max, "0xFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"sv);
+        const auto val = static_cast<unsigned __int128>(0xABCull) << 64 | 0x0123456789ABCDEFull;
+        CHECK_EQ(cst_fmt::format<fmt_str_x>(val), "0xABC0123456789ABCDEF"sv);
+    }
+#endif
+}
+
+
+TEST_CASE("%b and %o integral limits")
+{
+    static constexpr auto fmt_str_b = "%b"sv;
+    static constexpr auto fmt_str_o = "%o"sv;
+
+    SUBCASE("8 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_b>(std::numeric_limits<uint8_t>::max());
+        CHECK_EQ(formatted_max, "0b11111111"sv);
+        CHECK_EQ(formatted_max.size(), formatted_max.effective_size() + 1);
+        const int8_t min = std::numeric_limits<int8_t>::min();
+        CHECK_EQ(cst_fmt::format<fmt_str_b>(min), "0b10000000"sv);
+        CHECK_EQ(cst_fmt::format<fmt_str_o>(min), "0o200"sv);
+        constexpr auto formatted_bool = cst_fmt::format<fmt_str_b>(true);
+        CHECK_EQ(formatted_bool, "0b1"sv);
+        const bool false_val = false;
+        CHECK_EQ(cst_fmt::format<fmt_str_o>(false_val), "0o0"sv);
+    }
+
+    SUBCASE("64 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_o>(std::numeric_limits<uint64_t>::max());
+        CHECK_EQ(formatted_max, "0o1777777777777777777777"sv);
+        CHECK_EQ(formatted_max.size(), formatted_max.effective_size() + 1);
+        const int64_t min = std::numeric_limits<int64_t>::min();
+        CHECK_EQ(cst_fmt::format<fmt_str_b>(min), "0b1" + std::string(63, '0'));
+        CHECK_EQ(cst_fmt::format<fmt_str_o>(min), "0o1000000000000000000000"sv);
+
+        constexpr auto formatted_digits = cst_fmt::format<fmt_str_o>(01234567012345670123ull);
+        CHECK_EQ(formatted_digits, "0o1234567012345670123"sv);
+        const uint64_t digits = 01234567012345670123ull;
+        CHECK_EQ(cst_fmt::format<fmt_str_o>(digits), "0o1234567012345670123"sv);
+        const uint32_t mask = 0b1010'0000'1111'0000'0000'0000'0000'0001u;
+        CHECK_EQ(cst_fmt::format<fmt_str_b>(mask), "0b10100000111100000000000000000001"sv);
+
+        const int64_t zero = 0;
+        CHECK_EQ(cst_fmt::format<fmt_str_b>(zero), "0b0"sv);
+        CHECK_EQ(cst_fmt::format<fmt_str_o>(zero), "0o0"sv);
+    }
+
+    SUBCASE("runtime and compile time")
+    {
+        // The vectorised runtime path matches the constant evaluation, for each number of digits
+        static constexpr auto fmt_str = "%b %o"sv;
+        constexpr auto fmt = cst_fmt::compile_format<fmt_str, uint64_t, uint64_t>();
+        const auto reference = [](uint64_t val, unsigned int shift, char prefix) {
+            std::string digits;
+            do {
+                digits.insert(digits.begin(), char('0' + (val & ((1u << shift) - 1))));
+                val >>= shift;
+            } while (val != 0);
+            return std::string("0") + prefix + digits;
+        };
+        uint64_t val = 1;
+        for (int i = 0; i < 200; i++, val = val * 3 + uint64_t(i % 2)) {
+            CAPTURE(val);
+            const auto result = cst_fmt::format(fmt, val, val);
+            CHECK_EQ(result, reference(val, 1, 'b') + " " + reference(val, 3, 'o'));
+            CHECK_EQ(cst_fmt::formatted_size(fmt, val, val), result.effective_size());
+        }
+    }
+
+#ifdef __SIZEOF_INT128__
+    SUBCASE("128 bits")
+    {
+        constexpr auto formatted_max = cst_fmt::format<fmt_str_o>(std::numeric_limits<unsigned __int128>::max());
+        CHECK_EQ(formatted_max, "0o3777777777777777777777777777777777777777777"sv);
+        CHECK_EQ(formatted_max.size(), formatted_max.effective_size() + 1);
+        const auto val = static_cast<unsigned __int128>(1) << 100 | 5;
+        CHECK_EQ(cst_fmt::format<fmt_str_b>(val), "0b1" + std::string(97, '0') + "101");
+    }
+#endif
+}
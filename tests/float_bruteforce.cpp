@@ -1,79 +1,167 @@
 
 #include "../const_format.h"
 
+#include <charconv>
 #include <cstdlib>
+#include <cstdio>
+#include <cstring>
 #include <iostream>
-#include <sstream>
 #include <random>
-#include <bitset>
 #include <iomanip>
 #include <chrono>
+#include <vector>
 
 
 using namespace std::literals::string_view_literals;
 
 
-union LongDouble
+static constexpr auto format_str = "%f"sv;
+
+
+uint64_t mismatches = 0;
+
+
+/**
+ * Number of significant digits of a formatted floating point number, ignoring leading and trailing zeros.
+ */
+size_t significant_digits(std::string_view str)
 {
-    struct {
-        uint64_t high;
-        uint64_t low;
-    };
-    unsigned __int128 bits;
-    long double val;
-};
+    str = str.substr(0, str.find('e'));
+    size_t first = str.find_first_of("123456789");
+    size_t last = str.find_last_of("123456789");
+    if (first == std::string_view::npos) {
+        return 1;
+    }
+    size_t count = last - first + 1;
+    if (str.find('.') > first && str.find('.') < last) {
+        count--;
+    }
+    return count;
+}
 
 
-static_assert(sizeof(LongDouble) == sizeof(long double));
+template<typename T>
+T parse(const char* str)
+{
+    if constexpr (std::is_same_v<T, float>) {
+        return std::strtof(str, nullptr);
+    }
+    else if constexpr (std::is_same_v<T, double>) {
+        return std::strtod(str, nullptr);
+    }
+    else {
+        return std::strtold(str, nullptr);
+    }
+}
 
 
-int main()
+template<typename T>
+T random_value(std::mt19937_64& rng)
 {
-    static constexpr auto format_str = "%f"sv;
-    constexpr auto format = cst_fmt::compile_format<format_str, long double>();
+    // Random bits, which gives values of all magnitudes
+    while (true) {
+        T val;
+        if constexpr (std::numeric_limits<T>::digits == 64) {
+            // x87 format: the integer bit of the significand must be set for normal numbers
+            const uint64_t significand = rng();
+            const uint16_t sign_exponent = rng();
+            const uint64_t integer_bit = (sign_exponent & 0x7FFF) != 0 ? uint64_t(1) << 63 : 0;
+            const uint64_t bits = (significand & ~(uint64_t(1) << 63)) | integer_bit;
+            std::memset(&val, 0, sizeof(val));
+            std::memcpy(&val, &bits, sizeof(bits));
+            std::memcpy(reinterpret_cast<char*>(&val) + sizeof(bits), &sign_exponent, sizeof(sign_exponent));
+        }
+        else {
+            const auto bits = static_cast<std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>>(rng());
+            std::memcpy(&val, &bits, sizeof(val));
+        }
+        if (std::isfinite(val)) {
+            return val;
+        }
+    }
+}
 
-    std::random_device rd;
-    std::independent_bits_engine<std::mt19937_64, 128, unsigned __int128> rng(rd());
 
+template<typename T>
+void check_type(const char* type_name, std::mt19937_64& rng, uint64_t N)
+{
     bool header_printed = false;
 
-    std::cout << std::setprecision(10);
+    std::vector<T> values(N);
+    for (T& val : values) {
+        val = random_value<T>(rng);
+    }
 
     const auto start = std::chrono::high_resolution_clock::now();
 
-    const unsigned long N = 100000;
+    for (const T& val : values) {
+        const auto res = cst_fmt::format<format_str>(val);
+        const T parsed = parse<T>(res.cbegin());
 
-    uint32_t count = 0;
-    while (count < N) {
-        LongDouble a{ .bits = rng() };
-        if (std::isnan(a.val)) {
-            continue;
-        }
-
-        auto res = cst_fmt::format(format, a.val);
-        long double parsed = std::strtold(res.cbegin(), nullptr);
-
-        std::stringstream stream;
-        stream << a.val;
-        long double expected;
-        stream >> expected;
+        // The result must be parsed back to the same value, with as few digits as possible
+        char expected[64];
+        const auto [end, ec] = std::to_chars(std::begin(expected), std::end(expected), val, std::chars_format::scientific);
+        const std::string_view expected_view(expected, end - expected);
 
-        if (expected != parsed) {
+        if (parsed != val || significant_digits(res.view()) != significant_digits(expected_view)) {
             if (!header_printed) {
-                std::cout << std::setw(20) << "Value" << "\t" << std::setw(20) << "Result" << "\t" << std::setw(20) << "Expected" << "\t" << std::setw(20) << "Parsed" << "\n";
+                std::cout << std::setw(30) << "Result" << "\t" << std::setw(30) << "Expected" << "\t" << std::setw(30) << "Parsed" << "\n";
                 header_printed = true;
             }
-            //std::cout << std::bitset<64>(a.high) << " " << std::bitset<64>(a.low) << "\t";
-            std::cout << std::setw(20) << a.val << "\t" << std::setw(20) << res.view();
-            std::cout << "\t" << std::setw(20) << expected << "\t" << std::setw(20) << parsed;
+            std::cout << std::setw(30) << res.view() << "\t" << std::setw(30) << expected_view << "\t" << std::setw(30) << parsed;
             std::cout << "\n";
+            mismatches++;
         }
-
-        count++;
     }
 
     const auto end = std::chrono::high_resolution_clock::now();
     std::chrono::duration<double, std::milli> time = end - start;
 
-    std::cout << N << " tests done in " << time.count() << " ms \n";
+    std::cout << N << " " << type_name << " tests done in " << time.count() << " ms \n";
+
+    // Throughput
+    char buffer[64];
+    volatile char sink;
+
+    const auto time_per_op = [&](auto&& func) {
+        const auto start = std::chrono::high_resolution_clock::now();
+        for (const T& val : values) {
+            func(val);
+        }
+        const auto end = std::chrono::high_resolution_clock::now();
+        std::chrono::duration<double, std::nano> time = end - start;
+        return time.count() / double(values.size());
+    };
+
+    const double cst_fmt_time = time_per_op([&](const T& val) {
+        const auto res = cst_fmt::format<format_str>(val);
+        sink = res[res.effective_size() - 1];
+    });
+
+    const double to_chars_time = time_per_op([&](const T& val) {
+        const auto res = std::to_chars(std::begin(buffer), std::end(buffer), val);
+        sink = res.ptr[-1];
+    });
+
+    std::cout << std::setprecision(3) << std::fixed;
+    std::cout << "\tcst_fmt::format:\t" << cst_fmt_time << " ns/op\n";
+    std::cout << "\tstd::to_chars:\t\t" << to_chars_time << " ns/op\n";
+    std::cout << std::defaultfloat;
+}
+
+
+int main()
+{
+    std::random_device rd;
+    std::mt19937_64 rng(rd());
+
+    const uint64_t N = 100000;
+
+    check_type<float>("float", rng, N);
+    check_type<double>("double", rng, N);
+    check_type<long double>("long double", rng, N);
+
+    std::cout << mismatches << " mismatches\n";
+
+    return mismatches == 0 ? 0 : 1;
 }
@@ -1,6 +1,7 @@
-
 #include "tests.h"
 
+#include <cmath>
+#include <cstdio>
 #include <cstdlib>
 #include <iostream>
 #include <sstream>
@@ -28,17 +29,12 @@ TEST_CASE("%f")
             const auto result = cst_fmt::format(format, val);
             long double parsed = std::strtold(result.cbegin(), nullptr);
 
-            std::stringstream stream;
-            stream << val;
-            long double expected;
-            stream >> expected;
-
             // I don't use CHECK_EQ because of a Doctest quirk with long doubles. By quirk, I mean SIGSEGV. I can't reproduce it in another context, however.
             // Also, on failure, Doctest prints the entire number. Even for 1e4000. All 4000 characters. Yes. Why.
-            bool res = parsed == expected;
+            bool res = parsed == val;
             CHECK(res);
             if (!res) {
-                std::cout << "Failed: " << parsed << " == " << expected << "\n";
+                std::cout << "Failed: " << result << " == " << val << "\n";
             }
         }
     }
@@ -60,14 +56,10 @@ TEST_CASE("%f")
             const auto result = cst_fmt::format(format, val);
             long double parsed = std::strtold(result.cbegin(), nullptr);
 
-            std::stringstream stream;
-            stream << val;
-            long double expected = std::strtold(stream.rdbuf()->str().c_str(), nullptr);
-
-            bool res = parsed == expected;
+            bool res = parsed == val && std::signbit(parsed) == std::signbit(val);
             CHECK(res);
             if (!res) {
-                std::cout << "Failed: " << parsed << " == " << expected << "\n";
+                std::cout << "Failed: " << result << " == " << val << "\n";
             }
         }
     }
@@ -83,7 +75,9 @@ TEST_CASE("%f")
             stream << val;
             long double expected = std::strtold(stream.rdbuf()->str().c_str(), nullptr);
 
-            bool res = std::bit_cast<__int128>(parsed) == std::bit_cast<__int128>(expected);
+            // NaNs never compare equal: only their sign is checked
+            bool res = (parsed == expected || (std::isnan(parsed) && std::isnan(expected)))
+                       && std::signbit(parsed) == std::signbit(expected);
             CHECK(res);
             if (!res) {
                 std::cout << "Failed: " << parsed << " == " << expected << "\n";
@@ -91,3 +85,166 @@ TEST_CASE("%f")
         }
     }
 }
+
+
+TEST_CASE("%f shortest representation")
+{
+    static constexpr auto format_str = "%f"sv;
+
+    SUBCASE("double")
+    {
+        constexpr auto tenth = cst_fmt::format<format_str>(0.1);
+        CHECK_EQ(tenth, "0.1"sv);
+        constexpr auto third = cst_fmt::format<format_str>(1.0 / 3);
+        CHECK_EQ(third, "0.3333333333333333"sv);
+        constexpr auto sum = cst_fmt::format<format_str>(0.1 + 0.2);
+        CHECK_EQ(sum, "0.30000000000000004"sv);
+        constexpr auto whole = cst_fmt::format<format_str>(12345.0);
+        CHECK_EQ(whole, "12345"sv);
+        constexpr auto decimal = cst_fmt::format<format_str>(-1234.5678);
+        CHECK_EQ(decimal, "-1234.5678"sv);
+        constexpr auto small = cst_fmt::format<format_str>(0.0001);
+        CHECK_EQ(small, "0.0001"sv);
+        constexpr auto smaller = cst_fmt::format<format_str>(0.00001);
+        CHECK_EQ(smaller, "1e-5"sv);
+        constexpr auto big = cst_fmt::format<format_str>(123456.0);
+        CHECK_EQ(big, "1.23456e+5"sv);
+        constexpr auto max = cst_fmt::format<format_str>(std::numeric_limits<double>::max());
+        CHECK_EQ(max, "1.7976931348623157e+308"sv);
+        constexpr auto denorm_min = cst_fmt::format<format_str>(std::numeric_limits<double>::denorm_min());
+        CHECK_EQ(denorm_min, "5e-324"sv);
+        constexpr auto negative_zero = cst_fmt::format<format_str>(-0.0);
+        CHECK_EQ(negative_zero, "-0"sv);
+    }
+
+    SUBCASE("float")
+    {
+        constexpr auto tenth = cst_fmt::format<format_str>(0.1f);
+        CHECK_EQ(tenth, "0.1"sv);
+        constexpr auto third = cst_fmt::format<format_str>(1.0f / 3);
+        CHECK_EQ(third, "0.33333334"sv);
+        constexpr auto max = cst_fmt::format<format_str>(std::numeric_limits<float>::max());
+        CHECK_EQ(max, "3.4028235e+38"sv);
+        constexpr auto denorm_min = cst_fmt::format<format_str>(std::numeric_limits<float>::denorm_min());
+        CHECK_EQ(denorm_min, "1e-45"sv);
+    }
+
+    SUBCASE("long double")
+    {
+        constexpr auto tenth = cst_fmt::format<format_str>(0.1l);
+        CHECK_EQ(tenth, "0.1"sv);
+        constexpr auto third = cst_fmt::format<format_str>(1.0l / 3);
+        CHECK_EQ(third, "0.33333333333333333334"sv);
+        constexpr auto max = cst_fmt::format<format_str>(std::numeric_limits<long double>::max());
+        CHECK_EQ(max, "1.189731495357231765e+4932"sv);
+        constexpr auto denorm_min = cst_fmt::format<format_str>(std::numeric_limits<long double>::denorm_min());
+        CHECK_EQ(denorm_min, "4e-4951"sv);
+        constexpr auto negative_zero = cst_fmt::format<format_str>(-0.0l);
+        CHECK_EQ(negative_zero, "-0"sv);
+    }
+}
+
+
+TEST_CASE("%f and %e precision")
+{
+    static constexpr auto fixed_3 = "%.3f"sv;
+    static constexpr auto fixed_0 = "%.0f"sv;
+    static constexpr auto fixed_9 = "%.9f"sv;
+    static constexpr auto fixed_20 = "%.20f"sv;
+    static constexpr auto scientific_3 = "%.3e"sv;
+    static constexpr auto scientific_0 = "%.0e"sv;
+    static constexpr auto shortest_scientific = "%e"sv;
+
+    SUBCASE("Buffer size")
+    {
+        // Scientific notation: sign + 'd.ddde-ddd', and the '\0'
+        CHECK_EQ(cst_fmt::compile_format<scientific_3, double>().get_str_size(), 12);
+        CHECK_LT(cst_fmt::compile_format<scientific_3, double>().get_str_size(),
+                 cst_fmt::compile_format<shortest_scientific, double>().get_str_size());
+        // Fixed notation: sign + the 309 digits of the largest value + '.ddd', and the '\0'
+        CHECK_EQ(cst_fmt::compile_format<fixed_3, double>().get_str_size(), 315);
+        // sign + 39 digits + '.ddddddddd', and the '\0'
+        CHECK_EQ(cst_fmt::compile_format<fixed_9, float>().get_str_size(), 51);
+    }
+
+    SUBCASE("Fixed notation")
+    {
+        constexpr auto pi = cst_fmt::format<fixed_3>(3.14159265358979);
+        CHECK_EQ(pi, "3.142"sv);
+        constexpr auto negative = cst_fmt::format<fixed_3>(-0.0005f);
+        CHECK_EQ(negative, "-0.001"sv);
+        constexpr auto tie = cst_fmt::format<fixed_0>(2.5);
+        CHECK_EQ(tie, "2"sv);
+        constexpr auto other_tie = cst_fmt::format<fixed_0>(3.5);
+        CHECK_EQ(other_tie, "4"sv);
+        constexpr auto zero = cst_fmt::format<fixed_3>(0.0);
+        CHECK_EQ(zero, "0.000"sv);
+        constexpr auto exact = cst_fmt::format<fixed_20>(0.1);
+        CHECK_EQ(exact, "0.10000000000000000555"sv);
+        constexpr auto carry = cst_fmt::format<fixed_3>(99999.9996);
+        CHECK_EQ(carry, "100000.000"sv);
+        constexpr auto threshold = cst_fmt::format<fixed_3>(1e5);
+        CHECK_EQ(threshold, "100000.000"sv);
+        constexpr auto above = cst_fmt::format<fixed_3>(123456.789);
+        CHECK_EQ(above, "123456.789"sv);
+        constexpr auto integer = cst_fmt::format<fixed_0>(18446744073709551616.0);
+        CHECK_EQ(integer, "18446744073709551616"sv);
+        constexpr auto big = cst_fmt::format<fixed_3>(1e300);
+        CHECK_EQ(big, "1000000000000000052504760255204420248704468581108159154915854115511802457988908195786371375080447864"
+                      "0437044438328838781769425232353604305756447921847867069828483872009265758037378302337947880900593689"
+                      "5323497079994508111903896764088007465274278014249457925878882005684283811566947219638686545940054016"
+                      "0.000"sv);
+        constexpr auto nan = cst_fmt::format<fixed_3>(-std::numeric_limits<double>::quiet_NaN());
+        CHECK_EQ(nan, "-nan"sv);
+    }
+
+    SUBCASE("Fixed notation of large values")
+    {
+        // All the digits of the integer part, as printed by snprintf
+        char expected[5000];
+        const auto check = [&]<typename T>(T val) {
+            if constexpr (std::is_same_v<T, long double>) {
+                std::snprintf(expected, sizeof(expected), "%.3Lf", val);
+            }
+            else {
+                std::snprintf(expected, sizeof(expected), "%.3f", double(val));
+            }
+            const auto result = cst_fmt::format<fixed_3>(val);
+            CHECK_EQ(result, std::string_view(expected));
+        };
+
+        for (double val = 99999.9; val < 1e308; val *= 7.3) {
+            check(val);
+            check(-val);
+        }
+        for (float val = 99999.9f; val < 1e38f; val *= 7.3f) {
+            check(val);
+        }
+        for (long double val = 99999.9l; val < 1e4932l; val *= 1e37l) {
+            check(val);
+        }
+        check(std::numeric_limits<double>::max());
+        check(std::numeric_limits<float>::max());
+        check(std::numeric_limits<long double>::max());
+        check(9223372036854775807.5l);
+        check(4503599627370495.5);
+    }
+
+    SUBCASE("Scientific notation")
+    {
+        constexpr auto pi = cst_fmt::format<scientific_3>(3.14159265358979);
+        CHECK_EQ(pi, "3.142e+0"sv);
+        constexpr auto rounded = cst_fmt::format<scientific_0>(9.96e-10f);
+        CHECK_EQ(rounded, "1e-9"sv);
+        constexpr auto zero = cst_fmt::format<scientific_3>(-0.0);
+        CHECK_EQ(zero, "-0.000e+0"sv);
+        constexpr auto denorm_min = cst_fmt::format<scientific_3>(std::numeric_limits<double>::denorm_min());
+        CHECK_EQ(denorm_min, "4.941e-324"sv);
+        constexpr auto max = cst_fmt::format<scientific_3>(std::numeric_limits<long double>::max());
+        CHECK_EQ(max, "1.190e+4932"sv);
+        constexpr auto long_denorm_min = cst_fmt::format<scientific_3>(std::numeric_limits<long double>::denorm_min());
+        CHECK_EQ(long_denorm_min, "3.645e-4951"sv);
+        constexpr auto shortest = cst_fmt::format<shortest_scientific>(12.5);
+        CHECK_EQ(shortest, "1.25e+1"sv);
+    }
+}
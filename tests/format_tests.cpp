@@ -0,0 +1,379 @@
+
+#include <string>
+#include <vector>
+
+#include "tests.h"
+#include "../const_format_parallel.h"
+
+
+TEST_CASE("exact size formatting")
+{
+    static constexpr auto fmt_str = "There is %d characters in %s, %f."sv;
+    static constexpr auto name = "this string"sv;
+
+    constexpr auto result = cst_fmt::format_exact<fmt_str, 42, cst_fmt::str_ref<name>{}, 3.5>();
+    constexpr auto expected = "There is 42 characters in this string, 3.5."sv;
+    CHECK_EQ(result, expected);
+
+    // Only the '\0' is added
+    CHECK_EQ(result.size(), expected.size() + 1);
+    CHECK_EQ(result.cstr()[expected.size()], '\0');
+    CHECK_LT(result.size(), cst_fmt::format<fmt_str>(42, cst_fmt::str_ref<name>{}, 3.5).size());
+
+    static constexpr auto empty_str = ""sv;
+    constexpr auto empty = cst_fmt::format_exact<empty_str>();
+    CHECK_EQ(empty, ""sv);
+    CHECK_EQ(empty.size(), 1);
+}
+
+
+TEST_CASE("trimmed results")
+{
+    // The effective size and the truncation flag fit in a single byte for short results
+    static_assert(sizeof(cst_fmt::FormattedCharArray<12>) == 13);
+    static_assert(sizeof(cst_fmt::FormattedCharArray<127>) == 128);
+    static_assert(sizeof(cst_fmt::FormattedCharArray<128>) == 130);
+    static_assert(sizeof(cst_fmt::FormattedCharArray<40000>) == 40004);
+
+    static constexpr auto fmt_str = "%d-%s"sv;
+    static constexpr auto full = cst_fmt::format<fmt_str>(-7, cst_fmt::sv<32, cst_fmt::Truncation::report>{"abc"});
+    CHECK_EQ(full.effective_size(), 6);
+    CHECK_FALSE(full.is_truncated());
+
+    constexpr auto shrunk = cst_fmt::shrink<full>();
+    CHECK_EQ(shrunk, "-7-abc"sv);
+    CHECK_EQ(shrunk.size(), 7);
+    CHECK_FALSE(shrunk.is_truncated());
+
+    const auto trimmed = full.trim<16>();
+    CHECK_EQ(trimmed, "-7-abc"sv);
+    CHECK_EQ(trimmed.cstr()[6], '\0');
+    CHECK_FALSE(trimmed.is_truncated());
+
+    const auto cut = full.trim<4>();
+    CHECK_EQ(cut, "-7-"sv);
+    CHECK_EQ(cut.cstr()[3], '\0');
+    CHECK(cut.is_truncated());
+
+    const auto truncated = cst_fmt::format<fmt_str>(1, cst_fmt::sv<2, cst_fmt::Truncation::report>{"abc"});
+    CHECK(truncated.is_truncated());
+    CHECK_EQ(truncated.effective_size(), 4);
+    CHECK(truncated.trim<8>().is_truncated());
+}
+
+
+TEST_CASE("uninitialized buffers")
+{
+    // Formatted at runtime, where the buffers are not zeroed: only the characters written and the '\0' are specified
+    static constexpr auto fmt_str = "%s=%5d|%f"sv;
+    const int value = -12;
+    const double number = 0.25;
+    const auto result = cst_fmt::format<fmt_str>(cst_fmt::sv<16>{"abcd"}, value, number);
+    CHECK_EQ(result.effective_size(), 15);
+    CHECK_EQ(result.view(), "abcd=  -12|0.25"sv);
+    CHECK_EQ(result.cstr()[result.effective_size()], '\0');
+    CHECK_FALSE(result.is_truncated());
+
+#ifdef CONSTEXPRFORMAT_ZERO_INIT
+    for (size_t i = result.effective_size(); i < result.size(); i++) {
+        CHECK_EQ(result[i], '\0');
+    }
+#endif
+}
+
+
+TEST_CASE("formatting to a buffer")
+{
+    static constexpr auto fmt_str = "%s: %d, %x, %.2f"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, cst_fmt::cstr<8>, int, int, double>();
+    constexpr auto expected = "value: -42, 0xFF, 1.50"sv;
+
+    SUBCASE("char*")
+    {
+        char buffer[fmt.get_str_size()];
+        char* end = cst_fmt::format_to(fmt, buffer, cst_fmt::cstr<8>{"value"}, -42, 255, 1.5);
+        CHECK_EQ(std::string_view(buffer, end), expected);
+    }
+
+    SUBCASE("span")
+    {
+        std::array<char, fmt.get_str_size() - 1> buffer{};
+        char* end = cst_fmt::format_to(fmt, std::span(buffer), cst_fmt::cstr<8>{"value"}, -42, 255, 1.5);
+        CHECK_EQ(std::string_view(buffer.data(), end), expected);
+    }
+
+    SUBCASE("output iterator")
+    {
+        std::string str = "prefix ";
+        cst_fmt::format_to(fmt, std::back_inserter(str), cst_fmt::cstr<8>{"value"}, -42, 255, 1.5);
+        CHECK_EQ(str, "prefix " + std::string(expected));
+    }
+
+    SUBCASE("constant evaluation")
+    {
+        constexpr auto result = [] {
+            std::array<char, 32> buffer{};
+            const char* end = cst_fmt::format_to(cst_fmt::compile_format<fmt_str, cst_fmt::cstr<8>, int, int, double>(),
+                                                 buffer.data(), cst_fmt::cstr<8>{"value"}, -42, 255, 1.5);
+            return std::pair{ buffer, size_t(end - buffer.data()) };
+        }();
+        CHECK_EQ(std::string_view(result.first.data(), result.second), expected);
+    }
+}
+
+
+TEST_CASE("compiled format literals")
+{
+    static constexpr auto fmt_str = "[%d] value=%.2f (%s)"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, int, double, cst_fmt::cstr<8>>();
+
+    constexpr auto& literals = fmt.get_literals();
+    CHECK_EQ(std::string_view(literals.data(), literals.size()), "[] value= ()"sv);
+
+    constexpr auto& holes = fmt.get_holes();
+    REQUIRE_EQ(holes.size(), 3);
+    CHECK_EQ(holes[0].literal_offset, 1);
+    CHECK_EQ(holes[0].max_width, std::numeric_limits<int>::digits10 + 2);
+    CHECK_EQ(holes[1].literal_offset, 9);
+    CHECK_EQ(holes[2].literal_offset, 11);
+    CHECK_EQ(holes[2].max_width, 8);
+
+    // Literals and holes account for the whole string, with its '\0'
+    size_t total = literals.size() + 1;
+    for (const auto& hole : holes) {
+        total += hole.max_width;
+    }
+    CHECK_EQ(total, fmt.get_str_size());
+
+    const auto result = cst_fmt::format(fmt, 7, 0.125, cst_fmt::cstr<8>{"ok"});
+    CHECK_EQ(result, "[7] value=0.12 (ok)"sv);
+}
+
+
+TEST_CASE("field width")
+{
+    static constexpr auto right_aligned = "[%6d|%8x|%8.2f|%4c]"sv;
+    constexpr auto right = cst_fmt::format<right_aligned>(-42, 255, 3.14159, 'c');
+    CHECK_EQ(right, "[   -42|    0xFF|    3.14|   c]"sv);
+
+    static constexpr auto left_aligned = "[%-6d|%-8x|%-8.2f|%-4c]"sv;
+    constexpr auto left = cst_fmt::format<left_aligned>(-42, 255, 3.14159, 'c');
+    CHECK_EQ(left, "[-42   |0xFF    |3.14    |c   ]"sv);
+
+    // Values longer than the width are not truncated
+    static constexpr auto too_small = "%2d"sv;
+    constexpr auto overflow = cst_fmt::format<too_small>(123456);
+    CHECK_EQ(overflow, "123456"sv);
+
+    // The width only increases the maximum length if it is larger
+    static constexpr auto no_width = "%d"sv;
+    static constexpr auto large_width = "%20d"sv;
+    CHECK_EQ(cst_fmt::compile_format<too_small, int>().get_str_size(),
+             cst_fmt::compile_format<no_width, int>().get_str_size());
+    CHECK_EQ(cst_fmt::compile_format<large_width, int>().get_str_size(), 21);
+}
+
+
+TEST_CASE("fixed layout")
+{
+    static constexpr auto fmt_str = "id=%d name=%-s ratio=%.1f;"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, uint16_t, cst_fmt::cstr<6>, float>(cst_fmt::fixed_layout);
+    static_assert(fmt.is_fixed_layout());
+
+    // Each field takes its maximum length: 5 digits for 'uint16_t', 6 characters for the string
+    CHECK_EQ(fmt.get_field_offset(0), 3);
+    CHECK_EQ(fmt.get_field_offset(1), 3 + 5 + 6);
+    CHECK_EQ(fmt.get_field_offset(2), 3 + 5 + 6 + 6 + 7);
+
+    const auto first = cst_fmt::format(fmt, uint16_t(7), cst_fmt::cstr<6>{"bob"}, 0.5f);
+    const auto second = cst_fmt::format(fmt, uint16_t(65535), cst_fmt::cstr<6>{"alicia"}, -1234.5f);
+    CHECK_EQ(first.effective_size(), fmt.get_str_size() - 1);
+    CHECK_EQ(second.effective_size(), fmt.get_str_size() - 1);
+    CHECK_EQ(first.view().substr(0, 21), "id=    7 name=bob    "sv);
+    CHECK_EQ(second.view().substr(0, 21), "id=65535 name=alicia "sv);
+    CHECK_EQ(first.view().substr(first.effective_size() - 4), "0.5;"sv);
+    CHECK_EQ(second.view().substr(second.effective_size() - 8), "-1234.5;"sv);
+
+    char buffer[fmt.get_str_size()];
+    char* end = cst_fmt::format_to(fmt, buffer, uint16_t(7), cst_fmt::cstr<6>{"bob"}, 0.5f);
+    CHECK_EQ(std::string_view(buffer, end), first.view());
+
+    constexpr auto constant = cst_fmt::format(fmt, uint16_t(42), cst_fmt::cstr<6>{"x"}, 2.0f);
+    CHECK_EQ(constant.view().substr(0, 21), "id=   42 name=x      "sv);
+}
+
+
+TEST_CASE("exact formatted size")
+{
+    static constexpr auto fmt_str = "a%d b%x c%.3f d%s e%c f%5d g%-6x h%e i%s;"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, int64_t, uint32_t, double, cst_fmt::cstr<8>, char, int,
+                                                 uint8_t, float, cst_fmt::sv<4>>();
+
+    const auto check = [&](auto... args) {
+        const auto str = cst_fmt::format(fmt, args...);
+        const size_t size = cst_fmt::formatted_size(fmt, args...);
+        CHECK_EQ(size, str.effective_size());
+        CHECK_EQ(cst_fmt::formatted_size<fmt_str>(args...), size);
+
+        // Exactly 'size' characters are written
+        std::vector<char> buffer(size + 1, '#');
+        char* end = cst_fmt::format_to(fmt, buffer.data(), args...);
+        CHECK_EQ(end, buffer.data() + size);
+        CHECK_EQ(buffer.back(), '#');
+        CHECK_EQ(std::string_view(buffer.data(), size), str.view());
+    };
+
+    check(int64_t(0), 0u, 0.0, cst_fmt::cstr<8>{""}, 'x', 0, uint8_t(0), 0.0f, cst_fmt::sv<4>{""});
+    check(std::numeric_limits<int64_t>::min(), 0xFFFFFFFFu, -1234.5678, cst_fmt::cstr<8>{"12345678"}, '%',
+          -123456, uint8_t(255), -1.5e-30f, cst_fmt::sv<4>{"too long"});
+    check(int64_t(999), 0x10u, 1e300, cst_fmt::cstr<8>{"abc"}, ' ', 99999, uint8_t(16), 3.0f, cst_fmt::sv<4>{"ab"});
+    for (int64_t i = 1; i < std::numeric_limits<int64_t>::max() / 10; i *= 10) {
+        CAPTURE(i);
+        check(i - 1, uint32_t(i), double(i) / 3, cst_fmt::cstr<8>{"x"}, 'c', int(i), uint8_t(i), float(i),
+              cst_fmt::sv<4>{"abcd"});
+    }
+
+    SUBCASE("fixed layout")
+    {
+        static constexpr auto row_str = "%3d|%-4x\n"sv;
+        constexpr auto row = cst_fmt::compile_format<row_str, int8_t, uint8_t>(cst_fmt::fixed_layout);
+        CHECK_EQ(cst_fmt::formatted_size(row, int8_t(1), uint8_t(0)), row.get_str_size() - 1);
+    }
+
+    SUBCASE("constant")
+    {
+        static constexpr auto const_str = "%d-%x-%s"sv;
+        static_assert(cst_fmt::formatted_size<const_str>(-10, 255u, cst_fmt::sv<8>{"abc"}) == 12);
+    }
+}
+
+
+TEST_CASE("string and arena sinks")
+{
+    static constexpr auto fmt_str = "%d:%s;"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, int, cst_fmt::sv<16>>();
+
+    CHECK_EQ(cst_fmt::format(fmt, 12, cst_fmt::sv<16>{"abc"}).str(), "12:abc;");
+
+    SUBCASE("string")
+    {
+        std::string out = "start ";
+        const std::string_view first = cst_fmt::format_append(fmt, out, -5, cst_fmt::sv<16>{"first"});
+        CHECK_EQ(first, "-5:first;"sv);
+        CHECK_EQ(out, "start -5:first;");
+
+        cst_fmt::format_append(fmt, out, 123456, cst_fmt::sv<16>{""});
+        CHECK_EQ(out, "start -5:first;123456:;");
+    }
+
+    SUBCASE("arena")
+    {
+        char buffer[64];
+        cst_fmt::BumpArena arena(buffer);
+
+        const std::string_view first = cst_fmt::format_append(fmt, arena, 1, cst_fmt::sv<16>{"one"});
+        CHECK_EQ(first, "1:one;"sv);
+        CHECK_EQ(arena.used(), first.size());
+
+        const std::string_view second = cst_fmt::format_append(fmt, arena, 22, cst_fmt::sv<16>{"two"});
+        CHECK_EQ(second, "22:two;"sv);
+        CHECK_EQ(second.data(), first.data() + first.size());
+        CHECK_EQ(std::string_view(buffer, arena.used()), "1:one;22:two;"sv);
+
+        // Not enough space left for the longest result
+        const size_t max_length = fmt.get_str_size() - 1;
+        while (arena.capacity() - arena.used() >= max_length) {
+            cst_fmt::format_append(fmt, arena, 0, cst_fmt::sv<16>{"0123456789abcdef"});
+        }
+        const std::string_view full = cst_fmt::format_append(fmt, arena, 0, cst_fmt::sv<16>{""});
+        CHECK(full.empty());
+        CHECK_EQ(full.data(), nullptr);
+
+        arena.reset();
+        CHECK_EQ(cst_fmt::format_append(fmt, arena, 3, cst_fmt::sv<16>{"three"}).data(), buffer);
+    }
+}
+
+
+TEST_CASE("batch formatting")
+{
+    static constexpr auto fmt_str = "%d,%x,%.2f,%s\n"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, int, uint16_t, double, cst_fmt::cstr<8>>();
+    using Record = std::tuple<int, uint16_t, double, cst_fmt::cstr<8>>;
+
+    const std::vector<Record> records{
+        { 1, uint16_t(255), 0.5, { "first" } },
+        { -42, uint16_t(0), 1234.5678, { "second" } },
+        { 2147483647, uint16_t(65535), -0.001, { "" } },
+    };
+
+    std::string expected;
+    for (const Record& record : records) {
+        expected += std::apply([&](const auto&... args) { return cst_fmt::format(fmt, args...).str(); }, record);
+    }
+
+    SUBCASE("vector")
+    {
+        std::vector<char> buffer(records.size() * (fmt.get_str_size() - 1));
+        char* end = cst_fmt::format_batch(fmt, records, buffer.data());
+        CHECK_EQ(std::string_view(buffer.data(), end - buffer.data()), expected);
+    }
+
+    SUBCASE("span")
+    {
+        std::vector<char> buffer(records.size() * (fmt.get_str_size() - 1));
+        char* end = cst_fmt::format_batch(fmt, std::span<const Record>(records), buffer.data());
+        CHECK_EQ(std::string_view(buffer.data(), end - buffer.data()), expected);
+    }
+
+    SUBCASE("empty")
+    {
+        char buffer[1];
+        CHECK_EQ(cst_fmt::format_batch(fmt, std::span<const Record>(), buffer), buffer);
+    }
+
+    SUBCASE("fixed layout")
+    {
+        static constexpr auto row_str = "%3d|%-4x\n"sv;
+        constexpr auto row = cst_fmt::compile_format<row_str, int8_t, uint8_t>(cst_fmt::fixed_layout);
+        const std::array<std::pair<int8_t, uint8_t>, 2> rows{ { { int8_t(-5), uint8_t(10) }, { int8_t(100), uint8_t(0) } } };
+        char buffer[2 * (row.get_str_size() - 1)];
+        char* end = cst_fmt::format_batch(row, rows, buffer);
+        CHECK_EQ(std::string_view(buffer, end - buffer), "  -5|0xA  \n 100|0x0  \n"sv);
+    }
+}
+
+
+TEST_CASE("parallel batch formatting")
+{
+    static constexpr auto fmt_str = "%d;%.3f;%s\n"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, int64_t, double, cst_fmt::sv<12>>();
+    using Record = std::tuple<int64_t, double, cst_fmt::sv<12>>;
+
+    // Records of very different lengths, so that each chunk must be moved
+    static constexpr std::string_view names[] = { "", "a", "medium", "quite long name" };
+    std::vector<Record> records;
+    for (int64_t i = 0; i < 10007; i++) {
+        records.emplace_back(i * i * (i % 3 == 0 ? -1 : 1), double(i) / 7, cst_fmt::sv<12>{ names[i % 4] });
+    }
+
+    std::vector<char> expected(records.size() * (fmt.get_str_size() - 1));
+    char* expected_end = cst_fmt::format_batch(fmt, records, expected.data());
+    const std::string_view expected_view(expected.data(), expected_end - expected.data());
+
+    for (unsigned int threads : { 1u, 2u, 3u, 8u }) {
+        CAPTURE(threads);
+        std::vector<char> buffer(records.size() * (fmt.get_str_size() - 1));
+        char* end = cst_fmt::format_batch(fmt, records, buffer.data(), cst_fmt::Parallel{ threads, 100 });
+        CHECK_EQ(std::string_view(buffer.data(), end - buffer.data()), expected_view);
+    }
+
+    SUBCASE("too few records")
+    {
+        std::vector<char> buffer(10 * (fmt.get_str_size() - 1));
+        const std::span<const Record> first_records(records.data(), 10);
+        char* end = cst_fmt::format_batch(fmt, first_records, buffer.data(), cst_fmt::parallel);
+        CHECK_EQ(std::string_view(buffer.data(), end - buffer.data()),
+                 expected_view.substr(0, end - buffer.data()));
+    }
+}
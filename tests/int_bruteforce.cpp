@@ -0,0 +1,156 @@
+
+#include "../const_format.h"
+
+#include <charconv>
+#include <cstdio>
+#include <iostream>
+#include <random>
+#include <iomanip>
+#include <chrono>
+#include <vector>
+
+
+using namespace std::literals::string_view_literals;
+
+
+static constexpr auto format_str = "%d"sv;
+
+
+uint64_t mismatches = 0;
+
+
+template<typename T>
+void check_value(const T& val)
+{
+    const auto res = cst_fmt::format<format_str>(val);
+
+    char expected[64];
+    const auto [end, ec] = std::to_chars(std::begin(expected), std::end(expected), val);
+    const std::string_view expected_view(expected, end - expected);
+
+    if (res.view() != expected_view) {
+        if (mismatches == 0) {
+            std::cout << std::setw(45) << "Result" << "\t" << std::setw(45) << "Expected" << "\n";
+        }
+        std::cout << std::setw(45) << res.view() << "\t" << std::setw(45) << expected_view << "\n";
+        mismatches++;
+    }
+}
+
+
+template<typename T>
+uint64_t check_type(std::mt19937_64& rng, uint64_t random_count)
+{
+    typedef typename std::make_unsigned<T>::type uT;
+
+    uint64_t count = 0;
+
+    // Boundaries of the type, and around each power of ten
+    const T boundaries[] = {
+        std::numeric_limits<T>::min(), T(std::numeric_limits<T>::min() + 1),
+        std::numeric_limits<T>::max(), T(std::numeric_limits<T>::max() - 1),
+        T(0), T(1), T(-1)
+    };
+    for (const T& val : boundaries) {
+        check_value(val);
+        count++;
+    }
+
+    for (uT p = 1; ; p *= 10) {
+        for (const uT val : { uT(p - 1), p, uT(p + 1) }) {
+            check_value(T(val));
+            check_value(T(uT(0) - val));
+            count += 2;
+        }
+        if (p > std::numeric_limits<uT>::max() / 10) {
+            break;
+        }
+    }
+
+    // Random values, with a random number of significant bits to cover all digit counts evenly
+    for (uint64_t i = 0; i < random_count; i++) {
+        uT bits = 0;
+        for (size_t j = 0; j < sizeof(uT); j += sizeof(uint64_t)) {
+            bits = uT(bits << (sizeof(uT) > sizeof(uint64_t) ? 64 : 0)) | uT(rng());
+        }
+        bits >>= rng() % std::numeric_limits<uT>::digits;
+        check_value(T(bits));
+        count++;
+    }
+
+    return count;
+}
+
+
+template<typename Func>
+double time_per_op(const std::vector<int64_t>& values, Func&& func)
+{
+    const auto start = std::chrono::high_resolution_clock::now();
+    for (const int64_t& val : values) {
+        func(val);
+    }
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::nano> time = end - start;
+    return time.count() / double(values.size());
+}
+
+
+int main()
+{
+    std::random_device rd;
+    std::mt19937_64 rng(rd());
+
+    const auto start = std::chrono::high_resolution_clock::now();
+
+    const uint64_t N = 100000;
+
+    uint64_t count = 0;
+    count += check_type<int8_t>(rng, N);
+    count += check_type<uint8_t>(rng, N);
+    count += check_type<int16_t>(rng, N);
+    count += check_type<uint16_t>(rng, N);
+    count += check_type<int32_t>(rng, N);
+    count += check_type<uint32_t>(rng, N);
+    count += check_type<int64_t>(rng, N);
+    count += check_type<uint64_t>(rng, N);
+#ifdef __SIZEOF_INT128__
+    count += check_type<__int128>(rng, N);
+    count += check_type<unsigned __int128>(rng, N);
+#endif
+
+    const auto end = std::chrono::high_resolution_clock::now();
+    std::chrono::duration<double, std::milli> time = end - start;
+
+    std::cout << count << " tests done in " << time.count() << " ms, " << mismatches << " mismatches\n";
+
+    // Throughput comparison on 64 bits integers of all lengths
+    std::vector<int64_t> values(1000000);
+    for (int64_t& val : values) {
+        val = int64_t(rng()) >> (rng() % 64);
+    }
+
+    char buffer[64];
+    volatile char sink;
+
+    const double cst_fmt_time = time_per_op(values, [&](int64_t val) {
+        const auto res = cst_fmt::format<format_str>(val);
+        sink = res[res.effective_size() - 1];
+    });
+
+    const double to_chars_time = time_per_op(values, [&](int64_t val) {
+        const auto res = std::to_chars(std::begin(buffer), std::end(buffer), val);
+        sink = res.ptr[-1];
+    });
+
+    const double snprintf_time = time_per_op(values, [&](int64_t val) {
+        const int length = std::snprintf(buffer, sizeof(buffer), "%lld", static_cast<long long>(val));
+        sink = buffer[length - 1];
+    });
+
+    std::cout << std::setprecision(3) << std::fixed;
+    std::cout << "cst_fmt::format:\t" << cst_fmt_time << " ns/op\n";
+    std::cout << "std::to_chars:\t\t" << to_chars_time << " ns/op\n";
+    std::cout << "snprintf:\t\t" << snprintf_time << " ns/op\n";
+
+    return mismatches == 0 ? 0 : 1;
+}
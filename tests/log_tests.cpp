@@ -0,0 +1,177 @@
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tests.h"
+#include "../const_format_log.h"
+
+
+namespace
+{
+    std::string read_file(std::FILE* file)
+    {
+        std::string content;
+        std::rewind(file);
+        char buffer[256];
+        size_t count;
+        while ((count = std::fread(buffer, 1, sizeof(buffer), file)) > 0) {
+            content.append(buffer, count);
+        }
+        return content;
+    }
+}
+
+
+TEST_CASE("deferred logging")
+{
+    static constexpr auto fmt_str = "%s: %d (%.2f)"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, cst_fmt::cstr<8>, int, double>();
+
+    SUBCASE("record layout")
+    {
+        using Layout = cst_fmt::log::RecordLayout<std::remove_const_t<decltype(fmt)>>;
+        CHECK_EQ(Layout::record_size % cst_fmt::log::record_alignment, 0);
+        CHECK_GE(Layout::record_size, sizeof(cst_fmt::log::RecordHeader) + 9 + sizeof(int) + sizeof(double));
+    }
+
+    SUBCASE("single thread")
+    {
+        std::FILE* file = std::tmpfile();
+        {
+            cst_fmt::log::Logger logger(file);
+            std::string str = "value";
+            CHECK(logger.log(fmt, cst_fmt::cstr<8>{str.c_str()}, 42, 0.5));
+            // The string is copied: it may change before the record is formatted
+            str = "other";
+            CHECK(logger.log(fmt, cst_fmt::cstr<8>{str.c_str()}, -1, 2.0));
+        }
+        CHECK_EQ(read_file(file), "value: 42 (0.50)\nother: -1 (2.00)\n");
+        std::fclose(file);
+    }
+
+    SUBCASE("truncated strings")
+    {
+        static constexpr auto str_fmt = "[%s]"sv;
+        constexpr auto ellipsis = cst_fmt::compile_format<str_fmt, cst_fmt::sv<5, cst_fmt::Truncation::ellipsis>>();
+        std::FILE* file = std::tmpfile();
+        {
+            cst_fmt::log::Logger logger(file);
+            logger.log(ellipsis, cst_fmt::sv<5, cst_fmt::Truncation::ellipsis>{"hello world"sv});
+            logger.log(ellipsis, cst_fmt::sv<5, cst_fmt::Truncation::ellipsis>{"hello"sv});
+        }
+        CHECK_EQ(read_file(file), "[he...]\n[hello]\n");
+        std::fclose(file);
+    }
+
+    SUBCASE("multiple threads, wrapping around the rings")
+    {
+        constexpr size_t threads_count = 4;
+        constexpr int records_count = 5000;
+
+        std::FILE* file = std::tmpfile();
+        uint64_t dropped;
+        uint64_t retries = 0;
+        int logged = 0;
+        {
+            cst_fmt::log::Logger<1024> logger(file);
+            std::vector<std::thread> threads;
+            std::vector<int> thread_logged(threads_count, 0);
+            std::vector<uint64_t> thread_retries(threads_count, 0);
+            for (size_t t = 0; t < threads_count; t++) {
+                threads.emplace_back([&, t] {
+                    for (int i = 0; i < records_count; i++) {
+                        while (!logger.log(fmt, cst_fmt::cstr<8>{"thread"}, int(t), double(i))) {
+                            thread_retries[t]++;
+                            std::this_thread::yield();
+                        }
+                        thread_logged[t]++;
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            for (size_t t = 0; t < threads_count; t++) {
+                logged += thread_logged[t];
+                retries += thread_retries[t];
+            }
+            dropped = logger.dropped();
+        }
+
+        const std::string content = read_file(file);
+        std::fclose(file);
+
+        size_t lines = 0;
+        for (char c : content) {
+            lines += c == '\n';
+        }
+        CHECK_EQ(lines, size_t(logged));
+        CHECK_EQ(logged, int(threads_count) * records_count);
+        CHECK_EQ(content.rfind("thread: ", 0), 0);
+        CHECK_EQ(dropped, retries);
+    }
+}
+
+
+TEST_CASE("binary logs")
+{
+    static constexpr auto request_str = "GET %-8s status=%d size=%'d time=%.3f id=%x"sv;
+    static constexpr auto misc_str = "%c %d %5d %e %f [%s] %b %o"sv;
+    static constexpr auto empty_str = "no arguments"sv;
+    using Truncated = cst_fmt::sv<5, cst_fmt::Truncation::ellipsis>;
+    constexpr auto request = cst_fmt::compile_format<request_str, cst_fmt::cstr<16>, int, uint64_t, double, uint64_t>();
+    constexpr auto misc = cst_fmt::compile_format<misc_str, char, bool, uint8_t, float, long double, Truncated, uint16_t,
+                                                  int>();
+    constexpr auto empty = cst_fmt::compile_format<empty_str>();
+
+    SUBCASE("identifiers")
+    {
+        using RequestRecord = cst_fmt::log::BinaryRecord<std::remove_const_t<decltype(request)>>;
+        using MiscRecord = cst_fmt::log::BinaryRecord<std::remove_const_t<decltype(misc)>>;
+        CHECK_EQ(RequestRecord::signature, "s16,i4,u8,f8,u8"sv);
+        CHECK_EQ(MiscRecord::signature, "c1,b1,u1,f4,f" + std::to_string(sizeof(long double)) + ",s5e,u2,i4");
+        CHECK_NE(RequestRecord::id, MiscRecord::id);
+
+        // The identifier depends on the types of the arguments
+        constexpr auto other = cst_fmt::compile_format<request_str, cst_fmt::cstr<16>, int64_t, uint64_t, double,
+                                                      uint64_t>();
+        CHECK_NE(cst_fmt::log::BinaryRecord<std::remove_const_t<decltype(other)>>::id, RequestRecord::id);
+    }
+
+    SUBCASE("decoding")
+    {
+        std::FILE* log_file = std::tmpfile();
+        cst_fmt::log::BinaryWriter writer(log_file);
+        std::string expected;
+
+        const auto log = [&](auto compiled, const auto&... args) {
+            writer.write(compiled, args...);
+            expected += cst_fmt::format(compiled, args...).view();
+            expected += '\n';
+        };
+        log(request, cst_fmt::cstr<16>{"/index.html"}, 200, uint64_t(1234567), 0.0125, uint64_t(0xDEADBEEF));
+        log(misc, 'x', true, uint8_t(7), 1.5f, -2.25l, Truncated{"hello world"sv}, uint16_t(0xA5), 0755);
+        log(empty);
+        log(request, cst_fmt::cstr<16>{"/a"}, -1, uint64_t(0), 12345.678, uint64_t(0));
+        log(misc, '\0', false, uint8_t(255), -0.0f, 1e300l, Truncated{"hi"sv}, uint16_t(0), -1);
+
+        std::FILE* manifest_file = std::tmpfile();
+        cst_fmt::log::FormatRegistry::instance().write_manifest(manifest_file);
+
+        std::rewind(manifest_file);
+        cst_fmt::log::Manifest manifest;
+        REQUIRE(manifest.read(manifest_file));
+
+        std::rewind(log_file);
+        std::string decoded;
+        while (manifest.decode_record(log_file, decoded)) {
+            decoded += '\n';
+        }
+        CHECK(std::feof(log_file));
+        CHECK_EQ(decoded, expected);
+
+        std::fclose(manifest_file);
+        std::fclose(log_file);
+    }
+}
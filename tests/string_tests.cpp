@@ -1,5 +1,7 @@
 ﻿
 #include <string>
+#include <cstring>
+#include <memory>
 
 #include "tests.h"
 
@@ -72,7 +74,9 @@ TEST_CASE("%s dynamic char array")
     {
         static constexpr auto fmt_str = "%s world"sv;
         constexpr auto fmt = cst_fmt::compile_format<fmt_str, cst_fmt::cstr<6>>();
-        for (const char* str : { "hello", "bye" }) {
+        // Each string has the N readable characters of the holder
+        static constexpr char strings[][6] = { "hello", "bye" };
+        for (const char* str : strings) {
             auto result = cst_fmt::format(fmt, cst_fmt::cstr<6>{str});
             std::string expected = std::string(str) + " world";
             CHECK_EQ(result, expected);
@@ -89,6 +93,108 @@ TEST_CASE("%s dynamic char array")
         std::string expected = std::string(str) + " world";
         CHECK_EQ(result, expected);
     }
+
+    SUBCASE("all lengths and alignments")
+    {
+        static constexpr auto fmt_str = "[%s]"sv;
+        constexpr auto fmt = cst_fmt::compile_format<fmt_str, cst_fmt::cstr<40>>();
+
+        // Strings shorter than N, and without a terminator, at every position of a vector block. The allocation ends
+        // right after the N characters, so that reading past them is caught by address sanitizers.
+        for (size_t start = 0; start < 32; start++) {
+            for (size_t length = 0; length <= 40; length++) {
+                const auto chars = std::make_unique<char[]>(start + 40);
+                char* str = chars.get() + start;
+                std::memset(str, 'a', 40);
+                if (length < 40) {
+                    str[length] = '\0';
+                }
+                auto result = cst_fmt::format(fmt, cst_fmt::cstr<40>{str});
+                std::string expected = "[";
+                expected.append(str, length);
+                expected += ']';
+                CHECK_EQ(result, expected);
+            }
+        }
+    }
+}
+
+
+TEST_CASE("%s dynamic string view")
+{
+    static constexpr auto fmt_str = "[%s]"sv;
+    constexpr auto fmt = cst_fmt::compile_format<fmt_str, cst_fmt::sv<6>>();
+    CHECK_EQ(fmt.get_str_size(), 9);
+
+    SUBCASE("hello")
+    {
+        const std::string str = "hello";
+        auto result = cst_fmt::format(fmt, cst_fmt::sv<6>{str});
+        CHECK_EQ(result, "[hello]"sv);
+    }
+
+    SUBCASE("clamped")
+    {
+        auto result = cst_fmt::format(fmt, cst_fmt::sv<6>{"hello world"sv});
+        CHECK_EQ(result, "[hello ]"sv);
+    }
+
+    SUBCASE("\\0")
+    {
+        auto result = cst_fmt::format(fmt, cst_fmt::sv<6>{"a\0b"sv});
+        CHECK_EQ(result, "[a\0b]"sv);
+    }
+
+    SUBCASE("constant evaluation")
+    {
+        constexpr auto result = cst_fmt::format(fmt, cst_fmt::sv<6>{"hello world"sv});
+        CHECK_EQ(result, "[hello ]"sv);
+    }
+}
+
+
+TEST_CASE("%s truncation")
+{
+    static constexpr auto fmt_str = "[%s]"sv;
+    static constexpr auto padded_fmt_str = "[%8s]"sv;
+    using Truncation = cst_fmt::Truncation;
+
+    SUBCASE("silent")
+    {
+        auto result = cst_fmt::format<fmt_str>(cst_fmt::cstr<5>{"hello world"});
+        CHECK_EQ(result, "[hello]"sv);
+        CHECK_FALSE(result.is_truncated());
+    }
+
+    SUBCASE("ellipsis")
+    {
+        auto result = cst_fmt::format<fmt_str>(cst_fmt::cstr<5, Truncation::ellipsis>{"hello world"});
+        CHECK_EQ(result, "[he...]"sv);
+        auto exact = cst_fmt::format<fmt_str>(cst_fmt::cstr<5, Truncation::ellipsis>{"hello"});
+        CHECK_EQ(exact, "[hello]"sv);
+        auto view = cst_fmt::format<fmt_str>(cst_fmt::sv<5, Truncation::ellipsis>{"hello world"sv});
+        CHECK_EQ(view, "[he...]"sv);
+        auto short_holder = cst_fmt::format<fmt_str>(cst_fmt::sv<2, Truncation::ellipsis>{"hello"sv});
+        CHECK_EQ(short_holder, "[..]"sv);
+        constexpr auto constant = cst_fmt::format<fmt_str>(cst_fmt::cstr<5, Truncation::ellipsis>{"hello world"});
+        CHECK_EQ(constant, "[he...]"sv);
+    }
+
+    SUBCASE("report")
+    {
+        auto result = cst_fmt::format<fmt_str>(cst_fmt::cstr<5, Truncation::report>{"hello world"});
+        CHECK_EQ(result, "[hello]"sv);
+        CHECK(result.is_truncated());
+        auto exact = cst_fmt::format<fmt_str>(cst_fmt::cstr<5, Truncation::report>{"hello"});
+        CHECK_FALSE(exact.is_truncated());
+        auto view = cst_fmt::format<fmt_str>(cst_fmt::sv<5, Truncation::report>{"hello world"sv});
+        CHECK(view.is_truncated());
+        auto padded = cst_fmt::format<padded_fmt_str>(cst_fmt::sv<5, Truncation::report>{"hello world"sv});
+        CHECK_EQ(padded, "[   hello]"sv);
+        CHECK(padded.is_truncated());
+        constexpr auto constant = cst_fmt::format<fmt_str>(cst_fmt::sv<5, Truncation::report>{"hello world"sv});
+        CHECK(constant.is_truncated());
+    }
 }
 
 
@@ -0,0 +1,63 @@
+
+#include "../const_format_log.h"
+
+#include <cstdio>
+#include <string>
+
+
+/**
+ * Renders a binary log written by 'cst_fmt::log::BinaryWriter' to text, using the manifest of the program.
+ * Usage: LogDecoder <manifest> <binary log> [output]
+ */
+int main(int argc, char** argv)
+{
+    if (argc < 3) {
+        std::fprintf(stderr, "Usage: %s <manifest> <binary log> [output]\n", argv[0]);
+        return 2;
+    }
+
+    std::FILE* manifest_file = std::fopen(argv[1], "r");
+    if (manifest_file == nullptr) {
+        std::fprintf(stderr, "Could not open the manifest '%s'\n", argv[1]);
+        return 1;
+    }
+    cst_fmt::log::Manifest manifest;
+    const bool manifest_ok = manifest.read(manifest_file);
+    std::fclose(manifest_file);
+    if (!manifest_ok) {
+        std::fprintf(stderr, "Malformed manifest '%s'\n", argv[1]);
+        return 1;
+    }
+
+    std::FILE* log_file = std::fopen(argv[2], "rb");
+    if (log_file == nullptr) {
+        std::fprintf(stderr, "Could not open the log '%s'\n", argv[2]);
+        return 1;
+    }
+    std::FILE* output = argc > 3 ? std::fopen(argv[3], "w") : stdout;
+    if (output == nullptr) {
+        std::fprintf(stderr, "Could not open the output '%s'\n", argv[3]);
+        return 1;
+    }
+
+    std::string line;
+    size_t records = 0;
+    while (manifest.decode_record(log_file, line)) {
+        line.push_back('\n');
+        std::fwrite(line.data(), 1, line.size(), output);
+        line.clear();
+        records++;
+    }
+
+    const bool complete = std::feof(log_file) || std::fgetc(log_file) == EOF;
+    std::fclose(log_file);
+    if (output != stdout) {
+        std::fclose(output);
+    }
+
+    if (!complete) {
+        std::fprintf(stderr, "Could not decode record %zu: unknown format or corrupted log\n", records);
+        return 1;
+    }
+    return 0;
+}